@@ -48,6 +48,15 @@ static inline Ref<Blob> blobFromData(ScriptExecutionContext* context, const unsi
     return Blob::create(context, WTFMove(value), Blob::normalizedContentType(contentType));
 }
 
+static inline Ref<Blob> blobFromBuffer(ScriptExecutionContext* context, const SharedBuffer& buffer, const String& contentType)
+{
+    Vector<uint8_t> value;
+    value.reserveInitialCapacity(buffer.size());
+    for (const auto& element : buffer)
+        value.append(reinterpret_cast<const uint8_t*>(element.segment->data()), element.segment->size());
+    return Blob::create(context, WTFMove(value), Blob::normalizedContentType(contentType));
+}
+
 // https://mimesniff.spec.whatwg.org/#http-quoted-string-token-code-point
 static bool isHTTPQuotedStringTokenCodePoint(UChar c)
 {
@@ -245,6 +254,35 @@ static void resolveWithTypeAndData(Ref<DeferredPromise>&& promise, FetchBodyCons
     }
 }
 
+static void resolveWithTypeAndBuffer(Ref<DeferredPromise>&& promise, FetchBodyConsumer::Type type, const String& contentType, const SharedBuffer& buffer)
+{
+    auto* context = promise->scriptExecutionContext();
+
+    switch (type) {
+    case FetchBodyConsumer::Type::ArrayBuffer:
+        fulfillPromiseWithArrayBuffer(WTFMove(promise), buffer.tryCreateArrayBuffer().get());
+        return;
+    case FetchBodyConsumer::Type::Blob:
+        promise->resolveCallbackValueWithNewlyCreated<IDLInterface<Blob>>([&buffer, &contentType, context](auto&) {
+            return blobFromBuffer(context, buffer, contentType);
+        });
+        return;
+    case FetchBodyConsumer::Type::JSON:
+        fulfillPromiseWithJSON(WTFMove(promise), TextResourceDecoder::textFromUTF8(buffer));
+        return;
+    case FetchBodyConsumer::Type::Text:
+        promise->resolve<IDLDOMString>(TextResourceDecoder::textFromUTF8(buffer));
+        return;
+    case FetchBodyConsumer::Type::FormData:
+        // Multipart parsing needs the body in one segment.
+        resolveWithTypeAndData(WTFMove(promise), type, contentType, reinterpret_cast<const unsigned char*>(buffer.data()), buffer.size());
+        return;
+    case FetchBodyConsumer::Type::None:
+        ASSERT_NOT_REACHED();
+        return;
+    }
+}
+
 void FetchBodyConsumer::clean()
 {
     m_buffer = nullptr;
@@ -280,7 +318,7 @@ void FetchBodyConsumer::resolve(Ref<DeferredPromise>&& promise, const String& co
             if (auto chunk = result.returnValue())
                 data->append(reinterpret_cast<const char*>(chunk->data), chunk->size);
             else
-                resolveWithTypeAndData(WTFMove(promise), type, contentType, reinterpret_cast<const unsigned char*>(data->data()), data->size());
+                resolveWithTypeAndBuffer(WTFMove(promise), type, contentType, data.get());
         });
         m_sink->pipeFrom(*stream);
         return;
@@ -362,7 +400,7 @@ Ref<Blob> FetchBodyConsumer::takeAsBlob(ScriptExecutionContext* context)
         return Blob::create(context, Vector<uint8_t>(), Blob::normalizedContentType(m_contentType));
 
     // FIXME: We should try to move m_buffer to Blob without doing extra copy.
-    return blobFromData(context, reinterpret_cast<const unsigned char*>(m_buffer->data()), m_buffer->size(), m_contentType);
+    return blobFromBuffer(context, *m_buffer, m_contentType);
 }
 
 String FetchBodyConsumer::takeAsText()
@@ -371,7 +409,7 @@ String FetchBodyConsumer::takeAsText()
     if (!m_buffer)
         return String();
 
-    auto text = TextResourceDecoder::textFromUTF8(reinterpret_cast<const unsigned char*>(m_buffer->data()), m_buffer->size());
+    auto text = TextResourceDecoder::textFromUTF8(*m_buffer);
     m_buffer = nullptr;
     return text;
 }
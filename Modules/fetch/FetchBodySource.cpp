@@ -36,6 +36,12 @@ FetchBodySource::FetchBodySource(FetchBodyOwner& bodyOwner)
 {
 }
 
+bool FetchBodySource::hasCapacity() const
+{
+    auto desiredSize = controller().desiredSize();
+    return desiredSize && *desiredSize > 0;
+}
+
 void FetchBodySource::setActive()
 {
     ASSERT(m_bodyOwner);
@@ -47,6 +47,9 @@ public:
 
     bool isCancelling() const { return m_isCancelling; }
 
+    // Whether the stream queue is below its high water mark and can take more chunks without a pull.
+    bool hasCapacity() const;
+
     void resolvePullPromise() { pullFinished(); }
     void detach() { m_bodyOwner = nullptr; }
 
@@ -276,8 +276,13 @@ void FetchResponse::BodyLoader::didSucceed()
     m_response.m_body->loadingSucceeded(m_response.contentType());
 
     if (m_response.m_readableStreamSource) {
+        auto& source = *m_response.m_readableStreamSource;
+        bool canEnqueue = true;
         if (m_response.body().consumer().hasData())
-            m_response.m_readableStreamSource->enqueue(m_response.body().consumer().takeAsArrayBuffer());
+            canEnqueue = source.enqueue(m_response.body().consumer().takeAsArrayBuffer());
+        while (canEnqueue && !m_pendingChunks.isEmpty())
+            canEnqueue = source.enqueue(m_pendingChunks.takeFirst());
+        m_pendingChunks.clear();
 
         m_response.closeStream();
     }
@@ -361,22 +366,36 @@ void FetchResponse::BodyLoader::didReceiveData(const char* data, size_t size)
 
     auto& source = *m_response.m_readableStreamSource;
 
-    if (!source.isPulling()) {
-        m_response.body().consumer().append(data, size);
+    // Copy the chunk once and keep it as its own ArrayBuffer instead of coalescing it into the consumer buffer,
+    // so that it can later be handed to the stream as is.
+    m_pendingChunks.append(ArrayBuffer::tryCreate(data, size));
+    if (!source.isPulling())
         return;
-    }
 
     if (m_response.body().consumer().hasData() && !source.enqueue(m_response.body().consumer().takeAsArrayBuffer())) {
         stop();
         return;
     }
-    if (!source.enqueue(ArrayBuffer::tryCreate(data, size))) {
+    if (!enqueuePendingChunks(source)) {
         stop();
         return;
     }
     source.resolvePullPromise();
 }
 
+bool FetchResponse::BodyLoader::enqueuePendingChunks(FetchBodySource& source)
+{
+    ASSERT(!m_pendingChunks.isEmpty());
+
+    // A pull always gets one chunk. Further chunks are only enqueued while the stream queue is below its
+    // high water mark, the rest stay here until the next pull.
+    do {
+        if (!source.enqueue(m_pendingChunks.takeFirst()))
+            return false;
+    } while (!m_pendingChunks.isEmpty() && source.hasCapacity());
+    return true;
+}
+
 bool FetchResponse::BodyLoader::start(ScriptExecutionContext& context, const FetchRequest& request)
 {
     m_credentials = request.fetchOptions().credentials;
@@ -497,6 +516,13 @@ void FetchResponse::feedStream()
             m_readableStreamSource->resolvePullPromise();
             return;
         }
+    } else if (m_bodyLoader && m_bodyLoader->hasPendingChunks()) {
+        if (!m_bodyLoader->enqueuePendingChunks(*m_readableStreamSource)) {
+            stop();
+            return;
+        }
+        m_readableStreamSource->resolvePullPromise();
+        return;
     } else if (!shouldCloseStream)
         return;
 
@@ -33,6 +33,7 @@
 #include "ReadableStreamSink.h"
 #include "ResourceResponse.h"
 #include <JavaScriptCore/TypedArrays.h>
+#include <wtf/Deque.h>
 #include <wtf/WeakPtr.h>
 
 namespace JSC {
@@ -132,6 +133,8 @@ private:
         void consumeDataByChunk(ConsumeDataByChunkCallback&&);
 
         RefPtr<SharedBuffer> startStreaming();
+        bool hasPendingChunks() const { return !m_pendingChunks.isEmpty(); }
+        bool enqueuePendingChunks(FetchBodySource&);
         NotificationCallback takeNotificationCallback() { return WTFMove(m_responseCallback); }
         ConsumeDataByChunkCallback takeConsumeDataCallback() { return WTFMove(m_consumeDataCallback); }
 
@@ -148,6 +151,8 @@ private:
         std::unique_ptr<FetchLoader> m_loader;
         Ref<PendingActivity<FetchResponse>> m_pendingActivity;
         FetchOptions::Credentials m_credentials;
+        // Network chunks received while the body stream was not pulling, each wrapped in its own ArrayBuffer.
+        Deque<RefPtr<JSC::ArrayBuffer>> m_pendingChunks;
     };
 
     mutable Optional<ResourceResponse> m_filteredResponse;
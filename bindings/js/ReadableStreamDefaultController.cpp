@@ -54,6 +54,30 @@ static bool invokeReadableStreamDefaultControllerFunction(JSC::JSGlobalObject& l
     return !scope.exception();
 }
 
+Optional<double> ReadableStreamDefaultController::desiredSize() const
+{
+    JSC::JSGlobalObject& lexicalGlobalObject = this->globalObject();
+    auto& vm = lexicalGlobalObject.vm();
+    JSC::JSLockHolder lock(vm);
+
+    auto* clientData = static_cast<JSVMClientData*>(vm.clientData);
+    auto& privateName = clientData->builtinFunctions().readableStreamInternalsBuiltins().readableStreamDefaultControllerGetDesiredSizePrivateName();
+
+    auto function = lexicalGlobalObject.get(&lexicalGlobalObject, privateName);
+    ASSERT(function.isCallable(vm));
+
+    JSC::MarkedArgumentBuffer arguments;
+    arguments.append(&jsController());
+
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+    auto callData = JSC::getCallData(vm, function);
+    auto result = call(&lexicalGlobalObject, function, callData, JSC::jsUndefined(), arguments);
+    EXCEPTION_ASSERT(!scope.exception() || isTerminatedExecutionException(vm, scope.exception()));
+    if (UNLIKELY(scope.exception()) || !result.isNumber())
+        return WTF::nullopt;
+    return result.asNumber();
+}
+
 void ReadableStreamDefaultController::close()
 {
     JSC::MarkedArgumentBuffer arguments;
@@ -48,6 +48,9 @@ public:
     void error(const Exception&);
     void close();
 
+    // Returns WTF::nullopt once the stream is errored.
+    Optional<double> desiredSize() const;
+
 private:
     JSReadableStreamDefaultController& jsController() const;
 
@@ -49,6 +49,7 @@
 #include "UserContentController.h"
 #include <wtf/NeverDestroyed.h>
 #include <wtf/text/CString.h>
+#include <wtf/text/StringConcatenateNumbers.h>
 
 namespace WebCore {
 
@@ -62,16 +63,94 @@ void ContentExtensionsBackend::addContentExtension(const String& identifier, Ref
     
     auto contentExtension = ContentExtension::create(identifier, WTFMove(compiledContentExtension), shouldCompileCSS);
     m_contentExtensions.set(identifier, WTFMove(contentExtension));
+    clearActionsCache();
 }
 
 void ContentExtensionsBackend::removeContentExtension(const String& identifier)
 {
     m_contentExtensions.remove(identifier);
+    clearActionsCache();
 }
 
 void ContentExtensionsBackend::removeAllContentExtensions()
 {
     m_contentExtensions.clear();
+    clearActionsCache();
+}
+
+String ContentExtensionsBackend::actionsCacheKey(const ResourceLoadInfo& resourceLoadInfo)
+{
+    // Spaces cannot appear in a valid URL string, so they unambiguously separate the parts of the key.
+    return makeString(resourceLoadInfo.getResourceFlags(), ' ', resourceLoadInfo.mainDocumentURL.string(), ' ', resourceLoadInfo.resourceURL.string());
+}
+
+const Vector<ActionsFromContentRuleList>* ContentExtensionsBackend::cachedActions(const String& key) const
+{
+    auto iterator = m_actionsCache.find(key);
+    if (iterator == m_actionsCache.end())
+        return nullptr;
+
+    m_actionsCacheRecentlyUsedKeys.appendOrMoveToLast(key);
+    return &iterator->value;
+}
+
+void ContentExtensionsBackend::cacheActions(const String& key, const Vector<ActionsFromContentRuleList>& actions) const
+{
+    if (m_actionsCache.size() >= maximumActionsCacheSize)
+        m_actionsCache.remove(m_actionsCacheRecentlyUsedKeys.takeFirst());
+
+    m_actionsCache.set(key, actions);
+    m_actionsCacheRecentlyUsedKeys.appendOrMoveToLast(key);
+}
+
+void ContentExtensionsBackend::clearActionsCache()
+{
+    m_actionsCache.clear();
+    m_actionsCacheRecentlyUsedKeys.clear();
+}
+
+ActionsFromContentRuleList ContentExtensionsBackend::actionsFromContentRuleList(ContentExtension& contentExtension, const CString& urlCString, ResourceFlags flags, const URL& topURL) const
+{
+    ActionsFromContentRuleList actionsStruct;
+    actionsStruct.contentRuleListIdentifier = contentExtension.identifier();
+
+    const CompiledContentExtension& compiledExtension = contentExtension.compiledExtension();
+
+    DFABytecodeInterpreter withoutConditionsInterpreter(compiledExtension.filtersWithoutConditionsBytecode(), compiledExtension.filtersWithoutConditionsBytecodeLength());
+    DFABytecodeInterpreter::Actions withoutConditionsActions = withoutConditionsInterpreter.interpret(urlCString, flags);
+
+    DFABytecodeInterpreter withConditionsInterpreter(compiledExtension.filtersWithConditionsBytecode(), compiledExtension.filtersWithConditionsBytecodeLength());
+    DFABytecodeInterpreter::Actions withConditionsActions = withConditionsInterpreter.interpretWithConditions(urlCString, flags, contentExtension.topURLActions(topURL));
+
+    const SerializedActionByte* actions = compiledExtension.actions();
+    const unsigned actionsLength = compiledExtension.actionsLength();
+
+    const Vector<uint32_t>& universalWithConditions = contentExtension.universalActionsWithConditions(topURL);
+    const Vector<uint32_t>& universalWithoutConditions = contentExtension.universalActionsWithoutConditions();
+    if (!withoutConditionsActions.isEmpty() || !withConditionsActions.isEmpty() || !universalWithConditions.isEmpty() || !universalWithoutConditions.isEmpty()) {
+        Vector<uint32_t> actionLocations;
+        actionLocations.reserveInitialCapacity(withoutConditionsActions.size() + withConditionsActions.size() + universalWithoutConditions.size() + universalWithConditions.size());
+        for (uint64_t actionLocation : withoutConditionsActions)
+            actionLocations.uncheckedAppend(static_cast<uint32_t>(actionLocation));
+        for (uint64_t actionLocation : withConditionsActions)
+            actionLocations.uncheckedAppend(static_cast<uint32_t>(actionLocation));
+        for (uint32_t actionLocation : universalWithoutConditions)
+            actionLocations.uncheckedAppend(actionLocation);
+        for (uint32_t actionLocation : universalWithConditions)
+            actionLocations.uncheckedAppend(actionLocation);
+        std::sort(actionLocations.begin(), actionLocations.end());
+
+        // Add actions in reverse order to properly deal with IgnorePreviousRules.
+        for (unsigned i = actionLocations.size(); i; i--) {
+            Action action = Action::deserialize(actions, actionsLength, actionLocations[i - 1]);
+            if (action.type() == ActionType::IgnorePreviousRules) {
+                actionsStruct.sawIgnorePreviousRules = true;
+                break;
+            }
+            actionsStruct.actions.append(WTFMove(action));
+        }
+    }
+    return actionsStruct;
 }
 
 auto ContentExtensionsBackend::actionsForResourceLoad(const ResourceLoadInfo& resourceLoadInfo) const -> Vector<ActionsFromContentRuleList>
@@ -84,6 +163,10 @@ auto ContentExtensionsBackend::actionsForResourceLoad(const ResourceLoadInfo& re
         || resourceLoadInfo.resourceURL.protocolIsData())
         return { };
 
+    auto cacheKey = actionsCacheKey(resourceLoadInfo);
+    if (auto* actions = cachedActions(cacheKey))
+        return *actions;
+
     const String& urlString = resourceLoadInfo.resourceURL.string();
     ASSERT_WITH_MESSAGE(urlString.isAllASCII(), "A decoded URL should only contain ASCII characters. The matching algorithm assumes the input is ASCII.");
     const auto urlCString = urlString.utf8();
@@ -91,49 +174,9 @@ auto ContentExtensionsBackend::actionsForResourceLoad(const ResourceLoadInfo& re
     Vector<ActionsFromContentRuleList> actionsVector;
     actionsVector.reserveInitialCapacity(m_contentExtensions.size());
     const ResourceFlags flags = resourceLoadInfo.getResourceFlags();
-    for (auto& contentExtension : m_contentExtensions.values()) {
-        ActionsFromContentRuleList actionsStruct;
-        actionsStruct.contentRuleListIdentifier = contentExtension->identifier();
-
-        const CompiledContentExtension& compiledExtension = contentExtension->compiledExtension();
-        
-        DFABytecodeInterpreter withoutConditionsInterpreter(compiledExtension.filtersWithoutConditionsBytecode(), compiledExtension.filtersWithoutConditionsBytecodeLength());
-        DFABytecodeInterpreter::Actions withoutConditionsActions = withoutConditionsInterpreter.interpret(urlCString, flags);
-        
-        URL topURL = resourceLoadInfo.mainDocumentURL;
-        DFABytecodeInterpreter withConditionsInterpreter(compiledExtension.filtersWithConditionsBytecode(), compiledExtension.filtersWithConditionsBytecodeLength());
-        DFABytecodeInterpreter::Actions withConditionsActions = withConditionsInterpreter.interpretWithConditions(urlCString, flags, contentExtension->topURLActions(topURL));
-        
-        const SerializedActionByte* actions = compiledExtension.actions();
-        const unsigned actionsLength = compiledExtension.actionsLength();
-        
-        const Vector<uint32_t>& universalWithConditions = contentExtension->universalActionsWithConditions(topURL);
-        const Vector<uint32_t>& universalWithoutConditions = contentExtension->universalActionsWithoutConditions();
-        if (!withoutConditionsActions.isEmpty() || !withConditionsActions.isEmpty() || !universalWithConditions.isEmpty() || !universalWithoutConditions.isEmpty()) {
-            Vector<uint32_t> actionLocations;
-            actionLocations.reserveInitialCapacity(withoutConditionsActions.size() + withConditionsActions.size() + universalWithoutConditions.size() + universalWithConditions.size());
-            for (uint64_t actionLocation : withoutConditionsActions)
-                actionLocations.uncheckedAppend(static_cast<uint32_t>(actionLocation));
-            for (uint64_t actionLocation : withConditionsActions)
-                actionLocations.uncheckedAppend(static_cast<uint32_t>(actionLocation));
-            for (uint32_t actionLocation : universalWithoutConditions)
-                actionLocations.uncheckedAppend(actionLocation);
-            for (uint32_t actionLocation : universalWithConditions)
-                actionLocations.uncheckedAppend(actionLocation);
-            std::sort(actionLocations.begin(), actionLocations.end());
-
-            // Add actions in reverse order to properly deal with IgnorePreviousRules.
-            for (unsigned i = actionLocations.size(); i; i--) {
-                Action action = Action::deserialize(actions, actionsLength, actionLocations[i - 1]);
-                if (action.type() == ActionType::IgnorePreviousRules) {
-                    actionsStruct.sawIgnorePreviousRules = true;
-                    break;
-                }
-                actionsStruct.actions.append(WTFMove(action));
-            }
-        }
-        actionsVector.uncheckedAppend(WTFMove(actionsStruct));
-    }
+    for (auto& contentExtension : m_contentExtensions.values())
+        actionsVector.uncheckedAppend(actionsFromContentRuleList(contentExtension.get(), urlCString, flags, resourceLoadInfo.mainDocumentURL));
+    cacheActions(cacheKey, actionsVector);
 #if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
     MonotonicTime addedTimeEnd = MonotonicTime::now();
     dataLogF("Time added: %f microseconds %s \n", (addedTimeEnd - addedTimeStart).microseconds(), resourceLoadInfo.resourceURL.string().utf8().data());
@@ -141,6 +184,58 @@ auto ContentExtensionsBackend::actionsForResourceLoad(const ResourceLoadInfo& re
     return actionsVector;
 }
 
+auto ContentExtensionsBackend::actionsForResourceLoads(const Vector<ResourceLoadInfo>& resourceLoadInfos) const -> Vector<Vector<ActionsFromContentRuleList>>
+{
+    Vector<Vector<ActionsFromContentRuleList>> actionsVectors(resourceLoadInfos.size());
+    if (m_contentExtensions.isEmpty())
+        return actionsVectors;
+
+    struct PendingLoad {
+        size_t index;
+        String cacheKey;
+        CString urlCString;
+        ResourceFlags flags;
+    };
+    Vector<PendingLoad> pendingLoads;
+    HashMap<String, size_t> pendingLoadIndices;
+    Vector<std::pair<size_t, size_t>> duplicateLoads;
+    for (size_t i = 0; i < resourceLoadInfos.size(); ++i) {
+        auto& resourceLoadInfo = resourceLoadInfos[i];
+        if (!resourceLoadInfo.resourceURL.isValid() || resourceLoadInfo.resourceURL.protocolIsData())
+            continue;
+
+        auto cacheKey = actionsCacheKey(resourceLoadInfo);
+        if (auto* actions = cachedActions(cacheKey)) {
+            actionsVectors[i] = *actions;
+            continue;
+        }
+
+        auto addResult = pendingLoadIndices.add(cacheKey, pendingLoads.size());
+        if (!addResult.isNewEntry) {
+            duplicateLoads.append({ i, pendingLoads[addResult.iterator->value].index });
+            continue;
+        }
+
+        const String& urlString = resourceLoadInfo.resourceURL.string();
+        ASSERT_WITH_MESSAGE(urlString.isAllASCII(), "A decoded URL should only contain ASCII characters. The matching algorithm assumes the input is ASCII.");
+        pendingLoads.append({ i, WTFMove(cacheKey), urlString.utf8(), resourceLoadInfo.getResourceFlags() });
+        actionsVectors[i].reserveInitialCapacity(m_contentExtensions.size());
+    }
+
+    // Iterating over the content extensions in the outer loop keeps each one's bytecode hot while all the URLs go through it.
+    for (auto& contentExtension : m_contentExtensions.values()) {
+        for (auto& load : pendingLoads)
+            actionsVectors[load.index].uncheckedAppend(actionsFromContentRuleList(contentExtension.get(), load.urlCString, load.flags, resourceLoadInfos[load.index].mainDocumentURL));
+    }
+
+    for (auto& load : pendingLoads)
+        cacheActions(load.cacheKey, actionsVectors[load.index]);
+    for (auto& duplicate : duplicateLoads)
+        actionsVectors[duplicate.first] = actionsVectors[duplicate.second];
+
+    return actionsVectors;
+}
+
 void ContentExtensionsBackend::forEach(const WTF::Function<void(const String&, ContentExtension&)>& apply)
 {
     for (auto& pair : m_contentExtensions)
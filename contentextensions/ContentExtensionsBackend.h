@@ -30,6 +30,7 @@
 #include "ContentExtension.h"
 #include "ContentExtensionRule.h"
 #include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
 #include <wtf/text/StringHash.h>
 #include <wtf/text/WTFString.h>
 
@@ -61,6 +62,9 @@ public:
 
     // - Internal WebCore Interface.
     WEBCORE_EXPORT Vector<ActionsFromContentRuleList> actionsForResourceLoad(const ResourceLoadInfo&) const;
+    // Runs each content extension's bytecode over all the loads before moving on to the next one.
+    // The results are in the same order as the loads.
+    WEBCORE_EXPORT Vector<Vector<ActionsFromContentRuleList>> actionsForResourceLoads(const Vector<ResourceLoadInfo>&) const;
     WEBCORE_EXPORT StyleSheetContents* globalDisplayNoneStyleSheet(const String& identifier) const;
 
     ContentRuleListResults processContentRuleListsForLoad(const URL&, OptionSet<ResourceType>, DocumentLoader& initiatingDocumentLoader);
@@ -71,7 +75,20 @@ public:
     void forEach(const Function<void(const String&, ContentExtension&)>&);
 
 private:
+    ActionsFromContentRuleList actionsFromContentRuleList(ContentExtension&, const CString& urlCString, ResourceFlags, const URL& topURL) const;
+
+    static String actionsCacheKey(const ResourceLoadInfo&);
+    const Vector<ActionsFromContentRuleList>* cachedActions(const String& key) const;
+    void cacheActions(const String& key, const Vector<ActionsFromContentRuleList>&) const;
+    void clearActionsCache();
+
     HashMap<String, Ref<ContentExtension>> m_contentExtensions;
+
+    // Recently computed actions, keyed by resource URL, main document URL and resource flags.
+    // Any change to the set of content extensions clears it.
+    static constexpr unsigned maximumActionsCacheSize = 128;
+    mutable HashMap<String, Vector<ActionsFromContentRuleList>> m_actionsCache;
+    mutable ListHashSet<String> m_actionsCacheRecentlyUsedKeys;
 };
 
 } // namespace ContentExtensions
@@ -69,9 +69,16 @@
 
 #if !UCONFIG_NO_COLLATION
 #include <unicode/usearch.h>
+#include <unicode/uset.h>
 #include <wtf/text/TextBreakIteratorInternalICU.h>
 #endif
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 namespace WebCore {
 
 using namespace WTF::Unicode;
@@ -106,6 +113,7 @@ private:
     bool isBadMatch(const UChar*, size_t length) const;
     bool isWordStartMatch(size_t start, size_t length) const;
     bool isWordEndMatch(size_t start, size_t length) const;
+    int nextLiteralMatch(size_t offset) const;
 
     const String m_target;
     const StringView::UpconvertedCharacters m_targetCharacters;
@@ -117,6 +125,11 @@ private:
     bool m_atBreak;
     bool m_needsMoreContext;
 
+    // Set when the collator orders the target and all of the buffered text by code unit,
+    // so that search() can skip ICU and compare characters directly.
+    bool m_targetIsLiteral { false };
+    bool m_bufferIsLiteral { true };
+
     const bool m_targetRequiresKanaWorkaround;
     Vector<UChar> m_normalizedTarget;
     mutable Vector<UChar> m_normalizedMatch;
@@ -1657,6 +1670,86 @@ static inline void unlockSearcher()
 #endif
 }
 
+// Printable ASCII, tab and newline all have distinct primary weights in the root collation, and
+// only letters carry a case (tertiary) difference, so unless the search locale tailors any of them
+// a collation match on such text is a code unit match, ignoring ASCII case below tertiary strength.
+static inline bool isLiteralSearchCharacter(UChar character)
+{
+    return (character >= ' ' && character <= '~') || character == '\t' || character == '\n';
+}
+
+static inline bool isLiteralSearchText(const UChar* characters, size_t length)
+{
+    return std::all_of(characters, characters + length, isLiteralSearchCharacter);
+}
+
+static bool searchCollatorTailorsASCII(const UCollator* collator)
+{
+    UErrorCode status = U_ZERO_ERROR;
+    if (ucol_getAttribute(collator, UCOL_ALTERNATE_HANDLING, &status) != UCOL_NON_IGNORABLE || U_FAILURE(status))
+        return true;
+
+    USet* tailoredSet = ucol_getTailoredSet(collator, &status);
+    if (U_FAILURE(status))
+        return true;
+
+    bool tailorsASCII = false;
+    int32_t itemCount = uset_getItemCount(tailoredSet);
+    for (int32_t i = 0; i < itemCount && !tailorsASCII; ++i) {
+        UChar32 rangeStart;
+        UChar32 rangeEnd;
+        UChar string[16];
+        status = U_ZERO_ERROR;
+        int32_t stringLength = uset_getItem(tailoredSet, i, &rangeStart, &rangeEnd, string, WTF_ARRAY_LENGTH(string), &status);
+        if (U_FAILURE(status)) {
+            // A contraction too long for the buffer; assume the worst.
+            tailorsASCII = true;
+        } else if (!stringLength)
+            tailorsASCII = isASCII(rangeStart);
+        else
+            tailorsASCII = std::any_of(string, string + stringLength, [](UChar character) { return isASCII(character); });
+    }
+    uset_close(tailoredSet);
+    return tailorsASCII;
+}
+
+static bool searcherCanMatchASCIILiterally()
+{
+    ASSERT(searcherInUse);
+    // The searcher's locale never changes, and the strength and comparator we set on it do not affect the
+    // answer for ASCII, so this only needs to be computed once.
+    static bool canMatchLiterally = !searchCollatorTailorsASCII(usearch_getCollator(searcher()));
+    return canMatchLiterally;
+}
+
+// Returns the first position at or after characters that holds either candidate, or end.
+static const UChar* findLiteralSearchCandidate(const UChar* characters, const UChar* end, UChar candidate, UChar alternateCandidate)
+{
+#if CPU(X86_SSE2)
+    __m128i candidateVector = _mm_set1_epi16(candidate);
+    __m128i alternateCandidateVector = _mm_set1_epi16(alternateCandidate);
+    for (; end - characters >= 8; characters += 8) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(chunk, candidateVector), _mm_cmpeq_epi16(chunk, alternateCandidateVector))))
+            break;
+    }
+#elif HAVE(ARM_NEON_INTRINSICS)
+    uint16x8_t candidateVector = vdupq_n_u16(candidate);
+    uint16x8_t alternateCandidateVector = vdupq_n_u16(alternateCandidate);
+    for (; end - characters >= 8; characters += 8) {
+        uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(characters));
+        uint64x2_t matches = vreinterpretq_u64_u16(vorrq_u16(vceqq_u16(chunk, candidateVector), vceqq_u16(chunk, alternateCandidateVector)));
+        if (vgetq_lane_u64(matches, 0) | vgetq_lane_u64(matches, 1))
+            break;
+    }
+#endif
+    for (; characters < end; ++characters) {
+        if (*characters == candidate || *characters == alternateCandidate)
+            break;
+    }
+    return characters;
+}
+
 // ICU's search ignores the distinction between small kana letters and ones
 // that are not small, and also characters that differ only in the voicing
 // marks when considering only primary collation strength differences.
@@ -1943,6 +2036,8 @@ inline SearchBuffer::SearchBuffer(const String& target, FindOptions options)
     usearch_setPattern(searcher, m_targetCharacters, targetLength, &status);
     ASSERT(status == U_ZERO_ERROR);
 
+    m_targetIsLiteral = isLiteralSearchText(m_targetCharacters, targetLength) && searcherCanMatchASCIILiterally();
+
     // The kana workaround requires a normalized copy of the target string.
     if (m_targetRequiresKanaWorkaround)
         normalizeCharacters(m_targetCharacters, targetLength, m_normalizedTarget);
@@ -1968,18 +2063,26 @@ inline size_t SearchBuffer::append(StringView text)
         m_buffer.shrink(0);
         m_prefixLength = 0;
         m_atBreak = false;
+        m_bufferIsLiteral = true;
     } else if (m_buffer.size() == m_buffer.capacity()) {
         memcpy(m_buffer.data(), m_buffer.data() + m_buffer.size() - m_overlap, m_overlap * sizeof(UChar));
         m_prefixLength -= std::min(m_prefixLength, m_buffer.size() - m_overlap);
         m_buffer.shrink(m_overlap);
+        if (!m_bufferIsLiteral && m_targetIsLiteral)
+            m_bufferIsLiteral = isLiteralSearchText(m_buffer.data(), m_buffer.size());
     }
 
     size_t oldLength = m_buffer.size();
     size_t usableLength = std::min<size_t>(m_buffer.capacity() - oldLength, text.length());
     ASSERT(usableLength);
     m_buffer.grow(oldLength + usableLength);
-    for (unsigned i = 0; i < usableLength; ++i)
-        m_buffer[oldLength + i] = foldQuoteMark(text[i]);
+    bool appendedLiteralText = true;
+    for (unsigned i = 0; i < usableLength; ++i) {
+        UChar character = foldQuoteMark(text[i]);
+        appendedLiteralText &= isLiteralSearchCharacter(character);
+        m_buffer[oldLength + i] = character;
+    }
+    m_bufferIsLiteral &= appendedLiteralText;
     return usableLength;
 }
 
@@ -2007,6 +2110,8 @@ inline void SearchBuffer::prependContext(StringView text)
     size_t usableLength = std::min(m_buffer.capacity() - m_prefixLength, text.length() - wordBoundaryContextStart);
     WTF::append(m_buffer, text.substring(text.length() - usableLength, usableLength));
     m_prefixLength += usableLength;
+    if (m_bufferIsLiteral)
+        m_bufferIsLiteral = isLiteralSearchText(m_buffer.data() + m_buffer.size() - usableLength, usableLength);
 
     if (wordBoundaryContextStart || m_prefixLength == m_buffer.capacity())
         m_needsMoreContext = false;
@@ -2148,6 +2253,34 @@ inline bool SearchBuffer::isWordStartMatch(size_t start, size_t length) const
     return wordBreakSearchStart == start;
 }
 
+int SearchBuffer::nextLiteralMatch(size_t offset) const
+{
+    ASSERT(m_targetIsLiteral);
+
+    const UChar* target = m_targetCharacters;
+    size_t targetLength = m_target.length();
+    if (m_buffer.size() < targetLength || offset > m_buffer.size() - targetLength)
+        return USEARCH_DONE;
+
+    bool caseInsensitive = m_options.contains(CaseInsensitive);
+    UChar firstCharacter = caseInsensitive ? toASCIILower(target[0]) : target[0];
+    UChar alternateFirstCharacter = caseInsensitive ? toASCIIUpper(target[0]) : target[0];
+
+    const UChar* characters = m_buffer.data();
+    const UChar* lastCandidate = characters + m_buffer.size() - targetLength;
+    for (const UChar* candidate = characters + offset; candidate <= lastCandidate; ++candidate) {
+        candidate = findLiteralSearchCandidate(candidate, lastCandidate + 1, firstCharacter, alternateFirstCharacter);
+        if (candidate > lastCandidate)
+            break;
+        bool matches = caseInsensitive
+            ? std::equal(target + 1, target + targetLength, candidate + 1, [](UChar a, UChar b) { return toASCIILower(a) == toASCIILower(b); })
+            : std::equal(target + 1, target + targetLength, candidate + 1);
+        if (matches)
+            return candidate - characters;
+    }
+    return USEARCH_DONE;
+}
+
 inline size_t SearchBuffer::search(size_t& start)
 {
     size_t size = m_buffer.size();
@@ -2159,17 +2292,25 @@ inline size_t SearchBuffer::search(size_t& start)
             return 0;
     }
 
-    UStringSearch* searcher = WebCore::searcher();
+    // Plain ASCII text can be matched without going through ICU; the result is the same.
+    bool useLiteralMatch = m_targetIsLiteral && m_bufferIsLiteral;
+    ASSERT(!useLiteralMatch || isLiteralSearchText(m_buffer.data(), size));
 
+    UStringSearch* searcher = WebCore::searcher();
     UErrorCode status = U_ZERO_ERROR;
-    usearch_setText(searcher, m_buffer.data(), size, &status);
-    ASSERT(status == U_ZERO_ERROR);
+    int matchStart;
+    if (useLiteralMatch)
+        matchStart = nextLiteralMatch(m_prefixLength);
+    else {
+        usearch_setText(searcher, m_buffer.data(), size, &status);
+        ASSERT(status == U_ZERO_ERROR);
 
-    usearch_setOffset(searcher, m_prefixLength, &status);
-    ASSERT(status == U_ZERO_ERROR);
+        usearch_setOffset(searcher, m_prefixLength, &status);
+        ASSERT(status == U_ZERO_ERROR);
 
-    int matchStart = usearch_next(searcher, &status);
-    ASSERT(status == U_ZERO_ERROR);
+        matchStart = usearch_next(searcher, &status);
+        ASSERT(status == U_ZERO_ERROR);
+    }
 
 nextMatch:
     if (!(matchStart >= 0 && static_cast<size_t>(matchStart) < size)) {
@@ -2193,18 +2334,25 @@ nextMatch:
         memcpy(m_buffer.data(), m_buffer.data() + size - overlap, overlap * sizeof(UChar));
         m_prefixLength -= std::min(m_prefixLength, size - overlap);
         m_buffer.shrink(overlap);
+        if (!m_bufferIsLiteral && m_targetIsLiteral)
+            m_bufferIsLiteral = isLiteralSearchText(m_buffer.data(), m_buffer.size());
         return 0;
     }
 
-    size_t matchedLength = usearch_getMatchedLength(searcher);
+    size_t matchedLength = useLiteralMatch ? m_target.length() : usearch_getMatchedLength(searcher);
     ASSERT_WITH_SECURITY_IMPLICATION(matchStart + matchedLength <= size);
 
     // If this match is "bad", move on to the next match.
     if (isBadMatch(m_buffer.data() + matchStart, matchedLength)
         || (m_options.contains(AtWordStarts) && !isWordStartMatch(matchStart, matchedLength))
         || (m_options.contains(AtWordEnds) && !isWordEndMatch(matchStart, matchedLength))) {
-        matchStart = usearch_next(searcher, &status);
-        ASSERT(status == U_ZERO_ERROR);
+        // Like usearch_next() without USEARCH_OVERLAP, resume after the rejected match.
+        if (useLiteralMatch)
+            matchStart = nextLiteralMatch(matchStart + matchedLength);
+        else {
+            matchStart = usearch_next(searcher, &status);
+            ASSERT(status == U_ZERO_ERROR);
+        }
         goto nextMatch;
     }
 
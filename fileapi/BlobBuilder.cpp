@@ -33,7 +33,10 @@
 #include "EndingType.h"
 
 #include "Blob.h"
+#include "BlobRegistryImpl.h"
+#include "BlobURL.h"
 #include "TextEncoding.h"
+#include "ThreadableBlobRegistry.h"
 #include <JavaScriptCore/ArrayBuffer.h>
 #include <JavaScriptCore/ArrayBufferView.h>
 #include <wtf/text/CString.h>
@@ -41,31 +44,52 @@
 
 namespace WebCore {
 
+// Binary data is gathered into parts of at most this size instead of one ever-growing vector,
+// so assembling a very large blob does not need a contiguous allocation of the whole thing.
+static const size_t maximumAppendableDataSize = 16 * 1024 * 1024;
+
+// Once this much data is buffered, the parts gathered so far are registered as a blob of their own,
+// which the registry then writes to a file, instead of holding all of the data until finalize().
+static const size_t spillableDataSize = BlobRegistryImpl::defaultFileBackingThreshold;
+
 BlobBuilder::BlobBuilder(EndingType endings)
     : m_endings(endings)
 {
 }
 
+BlobBuilder::~BlobBuilder()
+{
+    // The blob built from the parts holds its own references to the spilled data by now.
+    if (!m_spilledPartsURL.isEmpty())
+        ThreadableBlobRegistry::unregisterBlobURL(m_spilledPartsURL);
+}
+
 void BlobBuilder::append(RefPtr<ArrayBuffer>&& arrayBuffer)
 {
     if (!arrayBuffer)
         return;
-    m_appendableData.append(static_cast<const uint8_t*>(arrayBuffer->data()), arrayBuffer->byteLength());
+    appendBytes(static_cast<const uint8_t*>(arrayBuffer->data()), arrayBuffer->byteLength());
 }
 
 void BlobBuilder::append(RefPtr<ArrayBufferView>&& arrayBufferView)
 {
     if (!arrayBufferView)
         return;
-    m_appendableData.append(static_cast<const uint8_t*>(arrayBufferView->baseAddress()), arrayBufferView->byteLength());
+    appendBytes(static_cast<const uint8_t*>(arrayBufferView->baseAddress()), arrayBufferView->byteLength());
+}
+
+void BlobBuilder::appendBytes(const uint8_t* data, size_t length)
+{
+    if (!m_appendableData.isEmpty() && m_appendableData.size() + length > maximumAppendableDataSize)
+        flushAppendableData();
+    m_appendableData.append(data, length);
 }
 
 void BlobBuilder::append(RefPtr<Blob>&& blob)
 {
     if (!blob)
         return;
-    if (!m_appendableData.isEmpty())
-        m_items.append(BlobPart(WTFMove(m_appendableData)));
+    flushAppendableData();
     m_items.append(BlobPart(blob->url()));
 }
 
@@ -84,10 +108,33 @@ void BlobBuilder::append(const String& text)
     }
 }
 
+void BlobBuilder::flushAppendableData()
+{
+    if (m_appendableData.isEmpty())
+        return;
+    m_pendingDataSize += m_appendableData.size();
+    m_items.append(BlobPart(WTFMove(m_appendableData)));
+    if (m_pendingDataSize >= spillableDataSize)
+        spillItems();
+}
+
+void BlobBuilder::spillItems()
+{
+    // The new blob takes over the items of the previous one, so only the latest needs to stay registered.
+    URL spilledPartsURL = BlobURL::createInternalURL();
+    ThreadableBlobRegistry::registerBlobURL(spilledPartsURL, WTFMove(m_items), { });
+    if (!m_spilledPartsURL.isEmpty())
+        ThreadableBlobRegistry::unregisterBlobURL(m_spilledPartsURL);
+    m_spilledPartsURL = WTFMove(spilledPartsURL);
+
+    m_items = { };
+    m_items.append(BlobPart(m_spilledPartsURL));
+    m_pendingDataSize = 0;
+}
+
 Vector<BlobPart> BlobBuilder::finalize()
 {
-    if (!m_appendableData.isEmpty())
-        m_items.append(BlobPart(WTFMove(m_appendableData)));
+    flushAppendableData();
     return WTFMove(m_items);
 }
 
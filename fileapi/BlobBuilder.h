@@ -45,6 +45,7 @@ class Blob;
 class BlobBuilder {
 public:
     BlobBuilder(EndingType);
+    ~BlobBuilder();
 
     void append(RefPtr<JSC::ArrayBuffer>&&);
     void append(RefPtr<JSC::ArrayBufferView>&&);
@@ -54,9 +55,15 @@ public:
     Vector<BlobPart> finalize();
 
 private:
+    void appendBytes(const uint8_t*, size_t);
+    void flushAppendableData();
+    void spillItems();
+
     EndingType m_endings;
     Vector<BlobPart> m_items;
     Vector<uint8_t> m_appendableData;
+    size_t m_pendingDataSize { 0 };
+    URL m_spilledPartsURL;
 };
 
 } // namespace WebCore
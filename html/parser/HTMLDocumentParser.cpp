@@ -332,7 +332,10 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     if (shouldResume)
         m_parserScheduler->scheduleForResume();
 
-    if (isWaitingForScripts() && !isDetached()) {
+    // Keep the preload scanner ahead of the tree builder whenever we stop with input left over,
+    // not only when blocked on a script, so resources further down are requested while we yield.
+    bool shouldScanAhead = isWaitingForScripts() || (shouldResume && m_tokenizer.isInDataState());
+    if (shouldScanAhead && !isDetached()) {
         ASSERT(m_tokenizer.isInDataState());
         if (!m_preloadScanner) {
             m_preloadScanner = makeUnique<HTMLPreloadScanner>(m_options, document()->url(), document()->deviceScaleFactor());
@@ -420,8 +423,7 @@ void HTMLDocumentParser::append(RefPtr<StringImpl>&& inputSource)
             m_preloadScanner = nullptr;
         } else {
             m_preloadScanner->appendToEnd(source);
-            if (isWaitingForScripts())
-                m_preloadScanner->scan(*m_preloader, *document());
+            m_preloadScanner->scan(*m_preloader, *document());
         }
     }
 
@@ -494,6 +496,10 @@ void HTMLDocumentParser::finish()
     if (!m_input.haveSeenEndOfFile())
         m_input.markEndOfFile();
 
+    // Everything received has been scanned by now, so the preloader need not hold anything back.
+    if (m_preloader && !isStopped() && !isDetached() && document()->renderView())
+        m_preloader->didFinishScanning();
+
     attemptToEnd();
 }
 
@@ -172,6 +172,9 @@ public:
         request->setCrossOriginMode(m_crossOriginMode);
         request->setNonce(m_nonceAttribute);
         request->setScriptIsAsync(m_scriptIsAsync);
+        request->setIsRenderBlocking(isRenderBlocking());
+        if (m_widthAttribute && m_heightAttribute)
+            request->setImageSizeHint(IntSize(*m_widthAttribute, *m_heightAttribute));
 
         // According to the spec, the module tag ignores the "charset" attribute as the same to the worker's
         // importScript. But WebKit supports the "charset" for importScript intentionally. So to be consistent,
@@ -214,6 +217,14 @@ private:
                 m_sizesAttribute = attributeValue;
                 break;
             }
+            if (match(attributeName, widthAttr) && !m_widthAttribute) {
+                m_widthAttribute = parseDimensionHint(attributeValue);
+                break;
+            }
+            if (match(attributeName, heightAttr) && !m_heightAttribute) {
+                m_heightAttribute = parseDimensionHint(attributeValue);
+                break;
+            }
             if (m_document.settings().lazyImageLoadingEnabled()) {
                 if (match(attributeName, loadingAttr) && m_lazyloadAttribute.isNull()) {
                     m_lazyloadAttribute = attributeValue;
@@ -262,6 +273,9 @@ private:
             } else if (match(attributeName, asyncAttr)) {
                 m_scriptIsAsync = true;
                 break;
+            } else if (match(attributeName, deferAttr)) {
+                m_scriptIsDeferred = true;
+                break;
             }
             processImageAndScriptAttribute(attributeName, attributeValue);
             break;
@@ -315,6 +329,36 @@ private:
         return parsedAttribute.isStyleSheet && !parsedAttribute.isAlternate && !parsedAttribute.iconType && !parsedAttribute.isDNSPrefetch;
     }
 
+    static Optional<unsigned> parseDimensionHint(const String& value)
+    {
+        auto dimension = parseHTMLNonNegativeInteger(value);
+        if (!dimension)
+            return WTF::nullopt;
+        return dimension.value();
+    }
+
+    // Classic scripts without async or defer and style sheets hold up the first paint; everything else can wait.
+    bool isRenderBlocking() const
+    {
+        switch (m_tagId) {
+        case TagId::Script:
+            return m_moduleScript == PreloadRequest::ModuleScript::No && !m_scriptIsAsync && !m_scriptIsDeferred;
+        case TagId::Link:
+            return m_linkIsStyleSheet;
+        case TagId::Img:
+        case TagId::Input:
+        case TagId::Source:
+        case TagId::Meta:
+        case TagId::Unknown:
+        case TagId::Style:
+        case TagId::Base:
+        case TagId::Template:
+        case TagId::Picture:
+            break;
+        }
+        return false;
+    }
+
     void setUrlToLoad(const String& value, bool allowReplacement = false)
     {
         // We only respect the first src/href, per HTML5:
@@ -402,6 +446,9 @@ private:
     bool m_inputIsImage;
     bool m_scriptIsNomodule { false };
     bool m_scriptIsAsync { false };
+    bool m_scriptIsDeferred { false };
+    Optional<unsigned> m_widthAttribute;
+    Optional<unsigned> m_heightAttribute;
     float m_deviceScaleFactor;
     PreloadRequest::ModuleScript m_moduleScript { PreloadRequest::ModuleScript::No };
     ReferrerPolicy m_referrerPolicy { ReferrerPolicy::EmptyString };
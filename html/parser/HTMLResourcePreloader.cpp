@@ -29,13 +29,19 @@
 #include "CachedResourceLoader.h"
 #include "CrossOriginAccessControl.h"
 #include "Document.h"
+#include "FrameView.h"
 #include "ScriptElementCachedScriptFetcher.h"
 
 #include "MediaQueryEvaluator.h"
 #include "RenderView.h"
+#include <algorithm>
 
 namespace WebCore {
 
+// Low priority preloads beyond this many are held back so they do not compete for
+// connections with the render-blocking resources discovered further down the document.
+static const unsigned maximumLowPriorityRequestsInFlight = 6;
+
 URL PreloadRequest::completeURL(Document& document)
 {
     return document.completeURL(m_resourceURL, m_baseURL.isEmpty() ? document.baseURL() : m_baseURL);
@@ -65,27 +71,102 @@ CachedResourceRequest PreloadRequest::resourceRequest(Document& document)
     auto request = createPotentialAccessControlRequest(completeURL(document), WTFMove(options), document, crossOriginMode);
     request.setInitiator(m_initiator);
 
+    auto loadPriority = priority(document);
+    if (loadPriority != CachedResource::defaultPriorityForResourceType(m_resourceType))
+        request.setPriority(loadPriority);
+
+    return request;
+}
+
+ResourceLoadPriority PreloadRequest::priority(Document& document) const
+{
     // FIXME: Put priorities for various cases to some central place where they are easy to see.
     if (m_scriptIsAsync && m_resourceType == CachedResource::Type::Script && m_moduleScript == ModuleScript::No)
-        request.setPriority(ResourceLoadPriority::Low);
+        return ResourceLoadPriority::Low;
 
-    return request;
+    auto priority = CachedResource::defaultPriorityForResourceType(m_resourceType);
+    if (m_resourceType != CachedResource::Type::ImageResource || !m_imageSizeHint)
+        return priority;
+
+    // Tracking pixels and spacers never contribute to what the user sees.
+    if (m_imageSizeHint->width() <= 1 && m_imageSizeHint->height() <= 1)
+        return ResourceLoadPriority::VeryLow;
+
+    // An image declared at least half as wide as the viewport is likely hero content.
+    // Before the first layout the viewport has no width, and nothing is promoted.
+    auto* view = document.view();
+    if (view && view->layoutWidth() > 0 && m_imageSizeHint->width() >= (view->layoutWidth() + 1) / 2)
+        return ResourceLoadPriority::Medium;
+
+    return priority;
 }
 
 void HTMLResourcePreloader::preload(PreloadRequestStream requests)
 {
-    for (auto& request : requests)
-        preload(WTFMove(request));
+    Vector<PrioritizedRequest> prioritizedRequests;
+    prioritizedRequests.reserveInitialCapacity(requests.size());
+    for (auto& request : requests) {
+        auto priority = request->priority(m_document);
+        prioritizedRequests.uncheckedAppend({ WTFMove(request), priority });
+    }
+
+    // Render-blocking resources go first, then by priority; discovery order breaks ties.
+    std::stable_sort(prioritizedRequests.begin(), prioritizedRequests.end(), [](auto& a, auto& b) {
+        if (a.request->isRenderBlocking() != b.request->isRenderBlocking())
+            return a.request->isRenderBlocking();
+        return a.priority > b.priority;
+    });
+
+    issueDeferredRequests();
+    for (auto& request : prioritizedRequests)
+        issue(WTFMove(request));
 }
 
 void HTMLResourcePreloader::preload(std::unique_ptr<PreloadRequest> preload)
+{
+    auto priority = preload->priority(m_document);
+    issueDeferredRequests();
+    issue({ WTFMove(preload), priority });
+}
+
+bool HTMLResourcePreloader::canIssueLowPriorityRequest()
+{
+    m_lowPriorityRequestsInFlight.removeAllMatching([](auto& resource) {
+        return !resource->isLoading();
+    });
+    return m_lowPriorityRequestsInFlight.size() < maximumLowPriorityRequestsInFlight;
+}
+
+void HTMLResourcePreloader::issueDeferredRequests()
+{
+    while (!m_deferredRequests.isEmpty() && (m_hasFinishedScanning || canIssueLowPriorityRequest()))
+        issue(m_deferredRequests.takeFirst());
+}
+
+void HTMLResourcePreloader::didFinishScanning()
+{
+    // Nothing render-blocking can show up further down any more, so stop holding requests back.
+    m_hasFinishedScanning = true;
+    issueDeferredRequests();
+}
+
+void HTMLResourcePreloader::issue(PrioritizedRequest&& prioritizedRequest)
 {
     ASSERT(m_document.frame());
     ASSERT(m_document.renderView());
-    if (!preload->media().isEmpty() && !MediaQueryEvaluator::mediaAttributeMatches(m_document, preload->media()))
+    auto& preload = *prioritizedRequest.request;
+    if (!preload.media().isEmpty() && !MediaQueryEvaluator::mediaAttributeMatches(m_document, preload.media()))
         return;
 
-    m_document.cachedResourceLoader().preload(preload->resourceType(), preload->resourceRequest(m_document));
+    bool isLowPriority = prioritizedRequest.priority <= ResourceLoadPriority::Low;
+    if (isLowPriority && !m_hasFinishedScanning && !canIssueLowPriorityRequest()) {
+        m_deferredRequests.append(WTFMove(prioritizedRequest));
+        return;
+    }
+
+    auto resource = m_document.cachedResourceLoader().preload(preload.resourceType(), preload.resourceRequest(m_document));
+    if (isLowPriority && resource && resource.value() && resource.value()->isLoading())
+        m_lowPriorityRequestsInFlight.append(resource.value());
 }
 
 
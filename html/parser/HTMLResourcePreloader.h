@@ -26,7 +26,10 @@
 #pragma once
 
 #include "CachedResource.h"
+#include "CachedResourceHandle.h"
 #include "CachedResourceRequest.h"
+#include "IntSize.h"
+#include <wtf/Deque.h>
 
 namespace WebCore {
 
@@ -56,7 +59,14 @@ public:
     void setCrossOriginMode(const String& mode) { m_crossOriginMode = mode; }
     void setNonce(const String& nonce) { m_nonceAttribute = nonce; }
     void setScriptIsAsync(bool value) { m_scriptIsAsync = value; }
+    void setIsRenderBlocking(bool value) { m_isRenderBlocking = value; }
+    void setImageSizeHint(const IntSize& size) { m_imageSizeHint = size; }
     CachedResource::Type resourceType() const { return m_resourceType; }
+    bool isRenderBlocking() const { return m_isRenderBlocking; }
+
+    // The priority the request will be issued at, taking the width and height attributes
+    // of images into account relative to the viewport.
+    ResourceLoadPriority priority(Document&) const;
 
 private:
     URL completeURL(Document&);
@@ -70,6 +80,8 @@ private:
     String m_crossOriginMode;
     String m_nonceAttribute;
     bool m_scriptIsAsync { false };
+    bool m_isRenderBlocking { false };
+    Optional<IntSize> m_imageSizeHint;
     ModuleScript m_moduleScript;
     ReferrerPolicy m_referrerPolicy;
 };
@@ -87,8 +99,24 @@ public:
     void preload(PreloadRequestStream);
     void preload(std::unique_ptr<PreloadRequest>);
 
+    // Called once the parser has received all of its input. Issues the low priority
+    // requests that were held back and stops holding back new ones.
+    void didFinishScanning();
+
 private:
+    struct PrioritizedRequest {
+        std::unique_ptr<PreloadRequest> request;
+        ResourceLoadPriority priority;
+    };
+
+    void issue(PrioritizedRequest&&);
+    void issueDeferredRequests();
+    bool canIssueLowPriorityRequest();
+
     Document& m_document;
+    Deque<PrioritizedRequest> m_deferredRequests;
+    Vector<CachedResourceHandle<CachedResource>> m_lowPriorityRequestsInFlight;
+    bool m_hasFinishedScanning { false };
 };
 
 } // namespace WebCore
@@ -26,11 +26,13 @@
 #include "HTMLMetaCharsetParser.h"
 #include "HTMLNames.h"
 #include "MIMETypeRegistry.h"
+#include "SharedBuffer.h"
 #include "TextCodec.h"
 #include "TextEncoding.h"
 #include "TextEncodingDetector.h"
 #include "TextEncodingRegistry.h"
 #include <wtf/ASCIICType.h>
+#include <wtf/text/StringBuilder.h>
 
 
 namespace WebCore {
@@ -336,6 +338,24 @@ String TextResourceDecoder::textFromUTF8(const unsigned char* data, unsigned len
     return decoder->decodeAndFlush(reinterpret_cast<const char*>(data), length);
 }
 
+String TextResourceDecoder::textFromUTF8(const SharedBuffer& buffer)
+{
+    unsigned char prefix[3];
+    size_t prefixLength = 0;
+    for (const auto& element : buffer) {
+        size_t length = std::min(element.segment->size(), sizeof(prefix) - prefixLength);
+        memcpy(prefix + prefixLength, element.segment->data(), length);
+        prefixLength += length;
+        if (prefixLength == sizeof(prefix))
+            break;
+    }
+
+    auto decoder = TextResourceDecoder::create("text/plain", "UTF-8");
+    if (shouldPrependBOM(prefix, prefixLength))
+        decoder->decode("\xef\xbb\xbf", 3);
+    return decoder->decodeAndFlush(buffer);
+}
+
 void TextResourceDecoder::setEncoding(const TextEncoding& encoding, EncodingSource source)
 {
     // In case the encoding didn't exist, we keep the old one (helps some sites specifying invalid encodings).
@@ -660,6 +680,15 @@ String TextResourceDecoder::decodeAndFlush(const char* data, size_t length)
     return decoded + flush();
 }
 
+String TextResourceDecoder::decodeAndFlush(const SharedBuffer& buffer)
+{
+    StringBuilder builder;
+    for (const auto& element : buffer)
+        builder.append(decode(element.segment->data(), element.segment->size()));
+    builder.append(flush());
+    return builder.toString();
+}
+
 const TextEncoding* TextResourceDecoder::encodingForURLParsing()
 {
     // For UTF-{7,16,32}, we want to use UTF-8 for the query part as
@@ -28,6 +28,7 @@
 namespace WebCore {
 
 class HTMLMetaCharsetParser;
+class SharedBuffer;
 class TextCodec;
 
 class TextResourceDecoder : public RefCounted<TextResourceDecoder> {
@@ -47,6 +48,7 @@ public:
     WEBCORE_EXPORT ~TextResourceDecoder();
 
     static String textFromUTF8(const unsigned char* data, unsigned length);
+    static String textFromUTF8(const SharedBuffer&);
 
     void setEncoding(const TextEncoding&, EncodingSource);
     const TextEncoding& encoding() const { return m_encoding; }
@@ -58,6 +60,8 @@ public:
     WEBCORE_EXPORT String flush();
 
     WEBCORE_EXPORT String decodeAndFlush(const char* data, size_t length);
+    // Feeds the buffer one segment at a time rather than combining it into one segment first.
+    WEBCORE_EXPORT String decodeAndFlush(const SharedBuffer&);
 
     void setHintEncoding(const TextResourceDecoder* parentFrameDecoder);
    
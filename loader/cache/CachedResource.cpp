@@ -146,6 +146,7 @@ CachedResource::CachedResource(CachedResourceRequest&& request, Type type, const
     , m_hasUnknownEncoding(request.isLinkPreload())
     , m_switchingClientsToRevalidatedResource(false)
     , m_ignoreForRequestCount(request.ignoreForRequestCount())
+    , m_loadBypassesCache(false)
 {
     ASSERT(m_sessionID.isValid());
 
@@ -180,6 +181,7 @@ CachedResource::CachedResource(const URL& url, Type type, const PAL::SessionID&
     , m_hasUnknownEncoding(false)
     , m_switchingClientsToRevalidatedResource(false)
     , m_ignoreForRequestCount(false)
+    , m_loadBypassesCache(false)
 {
     ASSERT(m_sessionID.isValid());
 #ifndef NDEBUG
@@ -689,7 +691,7 @@ void CachedResource::setDecodedSize(unsigned size)
             memoryCache.removeFromLiveDecodedResourcesList(*this);
 
         // Update the cache's size totals.
-        memoryCache.adjustSize(hasClients(), delta);
+        memoryCache.adjustSize(*this, hasClients(), delta);
     }
 }
 
@@ -710,7 +712,7 @@ void CachedResource::setEncodedSize(unsigned size)
     if (allowsCaching() && inCache()) {
         auto& memoryCache = MemoryCache::singleton();
         memoryCache.insertInLRUList(*this);
-        memoryCache.adjustSize(hasClients(), delta);
+        memoryCache.adjustSize(*this, hasClients(), delta);
     }
 }
 
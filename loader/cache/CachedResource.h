@@ -252,6 +252,9 @@ public:
     bool isLinkPreload() { return m_isLinkPreload; }
     void setLinkPreload() { m_isLinkPreload = true; }
     bool hasUnknownEncoding() { return m_hasUnknownEncoding; }
+    // Whether the network load for this resource was started by a frame that was bypassing the cache, e.g. on reload.
+    bool loadBypassesCache() const { return m_loadBypassesCache; }
+    void setLoadBypassesCache(bool loadBypassesCache) { m_loadBypassesCache = loadBypassesCache; }
     void setHasUnknownEncoding(bool hasUnknownEncoding) { m_hasUnknownEncoding = hasUnknownEncoding; }
 
     void registerHandle(CachedResourceHandleBase*);
@@ -384,6 +387,7 @@ private:
     bool m_hasUnknownEncoding : 1;
     bool m_switchingClientsToRevalidatedResource : 1;
     bool m_ignoreForRequestCount : 1;
+    bool m_loadBypassesCache : 1;
 
 #if ASSERT_ENABLED
     bool m_deleted { false };
@@ -947,6 +947,8 @@ ResourceErrorOr<CachedResourceHandle<CachedResource>> CachedResourceLoader::requ
     auto& cookieJar = page.cookieJar();
 
     RevalidationPolicy policy = determineRevalidationPolicy(type, request, resource.get(), forPreload, imageLoading);
+    if (request.allowsCaching())
+        memoryCache.resourceRequested(type, url, policy == Use);
     switch (policy) {
     case Reload:
         memoryCache.remove(*resource);
@@ -1080,7 +1082,9 @@ CachedResourceHandle<CachedResource> CachedResourceLoader::loadResource(CachedRe
 
     LOG(ResourceLoading, "Loading CachedResource for '%s'.", request.resourceRequest().url().stringCenterEllipsizedToLength().latin1().data());
 
+    bool loadBypassesCache = cachePolicy(type, request.resourceRequest().url()) == CachePolicy::Reload;
     auto resource = createResource(type, WTFMove(request), sessionID, &cookieJar, settings);
+    resource->setLoadBypassesCache(loadBypassesCache);
 
     if (resource->allowsCaching())
         memoryCache.add(*resource);
@@ -1236,8 +1240,8 @@ CachedResourceLoader::RevalidationPolicy CachedResourceLoader::determineRevalida
     if (document() && !document()->loadEventFinished() && m_validatedURLs.contains(existingResource->url().string()))
         return Use;
 
-    // CachePolicy::Reload always reloads
-    if (cachePolicy == CachePolicy::Reload) {
+    // CachePolicy::Reload always reloads, unless the resource is still being loaded from the network by another reload.
+    if (cachePolicy == CachePolicy::Reload && !(existingResource->isLoading() && existingResource->loadBypassesCache())) {
         LOG(ResourceLoading, "CachedResourceLoader::determineRevalidationPolicy reloading due to CachePolicyReload.");
         logMemoryCacheResourceRequest(frame(), DiagnosticLoggingKeys::inMemoryCacheKey(), DiagnosticLoggingKeys::unusedReasonReloadKey());
         return Reload;
@@ -1257,7 +1261,8 @@ CachedResourceLoader::RevalidationPolicy CachedResourceLoader::determineRevalida
         // would be cancelled for all other DocumentLoaders as well.
         if (type == CachedResource::Type::MainResource)
             return Reload;
-        // For cached subresources that are still loading we ignore the cache policy.
+        // For cached subresources that are still loading we ignore the cache policy. This includes
+        // sharing a load that bypasses the cache with another frame that is reloading.
         return Use;
     }
 
@@ -33,9 +33,160 @@
 #include "RuntimeApplicationChecks.h"
 #include "SharedBuffer.h"
 #include "TextResourceDecoder.h"
+#include <wtf/Deque.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/WorkQueue.h>
+#include <wtf/text/StringBuilder.h>
 
 namespace WebCore {
 
+static WorkQueue& scriptDecodingQueue()
+{
+    static NeverDestroyed<Ref<WorkQueue>> queue(WorkQueue::create("org.webkit.CachedScriptDecoding", WorkQueue::Type::Serial, WorkQueue::QOS::UserInitiated));
+    return queue.get();
+}
+
+// Decodes a script on a background queue while it is loading, so that little is left to decode
+// when the load finishes. Segments that are all ASCII are only retained until the first non-ASCII
+// byte shows up, since such scripts are used without being decoded. Segments are handed to the
+// queue through m_queuedSegments rather than captured by the queued tasks, so that finish() can
+// decode whatever the queue has not got to yet instead of waiting behind other scripts.
+class CachedScriptStreamingDecoder : public ThreadSafeRefCounted<CachedScriptStreamingDecoder> {
+public:
+    static Ref<CachedScriptStreamingDecoder> create(const TextEncoding& encoding)
+    {
+        return adoptRef(*new CachedScriptStreamingDecoder(encoding));
+    }
+
+    size_t receivedSize() const { return m_receivedSize; }
+
+    void append(const SharedBuffer&);
+
+    // Decodes the rest of the data on the main thread. Returns nullopt if the data was all ASCII
+    // in a byte based encoding. Once this returns, decoder() is no longer used off the main thread.
+    Optional<String> finish(const SharedBuffer&);
+
+    void cancel();
+
+    TextResourceDecoder& decoder() { return m_decoder.get(); }
+
+private:
+    explicit CachedScriptStreamingDecoder(const TextEncoding& encoding)
+        : m_decoder(TextResourceDecoder::create("text/javascript"_s, encoding))
+        , m_isAllASCII(encoding.isByteBasedEncoding())
+    {
+    }
+
+    struct PendingSegment {
+        Ref<SharedBuffer::DataSegment> segment;
+        size_t offset;
+    };
+
+    unsigned queueSegments(const SharedBuffer&);
+    void decodeNextSegment();
+    void decodeSegment(PendingSegment&&);
+
+    // Only used on the main thread.
+    size_t m_receivedSize { 0 };
+
+    // The segments are decoded in order, on the queue or in finish(), while holding m_lock.
+    Lock m_lock;
+    Deque<PendingSegment> m_queuedSegments;
+    Ref<TextResourceDecoder> m_decoder;
+    StringBuilder m_builder;
+    Vector<PendingSegment> m_pendingASCIISegments;
+    bool m_isAllASCII;
+    bool m_isCancelled { false };
+};
+
+void CachedScriptStreamingDecoder::append(const SharedBuffer& data)
+{
+    for (unsigned count = queueSegments(data); count; --count) {
+        scriptDecodingQueue().dispatch([protectedThis = makeRef(*this)] {
+            protectedThis->decodeNextSegment();
+        });
+    }
+}
+
+unsigned CachedScriptStreamingDecoder::queueSegments(const SharedBuffer& data)
+{
+    ASSERT(isMainThread());
+    auto locker = holdLock(m_lock);
+    if (m_isCancelled)
+        return 0;
+
+    unsigned count = 0;
+    for (const auto& element : data) {
+        size_t segmentEnd = element.beginPosition + element.segment->size();
+        if (segmentEnd <= m_receivedSize)
+            continue;
+        size_t offset = m_receivedSize > element.beginPosition ? m_receivedSize - element.beginPosition : 0;
+        m_queuedSegments.append({ element.segment.copyRef(), offset });
+        m_receivedSize = segmentEnd;
+        ++count;
+    }
+    return count;
+}
+
+void CachedScriptStreamingDecoder::decodeNextSegment()
+{
+    ASSERT(!isMainThread());
+    auto locker = holdLock(m_lock);
+    // finish() or cancel() may have taken the segment already.
+    if (!m_queuedSegments.isEmpty())
+        decodeSegment(m_queuedSegments.takeFirst());
+}
+
+void CachedScriptStreamingDecoder::decodeSegment(PendingSegment&& pendingSegment)
+{
+    ASSERT(m_lock.isHeld());
+    const char* data = pendingSegment.segment->data() + pendingSegment.offset;
+    size_t length = pendingSegment.segment->size() - pendingSegment.offset;
+
+    if (m_isAllASCII) {
+        if (charactersAreAllASCII(reinterpret_cast<const LChar*>(data), length)) {
+            m_pendingASCIISegments.append(WTFMove(pendingSegment));
+            return;
+        }
+        m_isAllASCII = false;
+        for (auto& pending : m_pendingASCIISegments)
+            m_builder.append(m_decoder->decode(pending.segment->data() + pending.offset, pending.segment->size() - pending.offset));
+        m_pendingASCIISegments.clear();
+    }
+
+    m_builder.append(m_decoder->decode(data, length));
+}
+
+Optional<String> CachedScriptStreamingDecoder::finish(const SharedBuffer& data)
+{
+    ASSERT(isMainThread());
+    queueSegments(data);
+
+    // At most the segment the queue is working on is waited for; the rest is decoded here.
+    auto locker = holdLock(m_lock);
+    while (!m_queuedSegments.isEmpty())
+        decodeSegment(m_queuedSegments.takeFirst());
+    m_isCancelled = true;
+    m_pendingASCIISegments.clear();
+    if (m_isAllASCII)
+        return WTF::nullopt;
+
+    m_builder.append(m_decoder->flush());
+    String script = m_builder.toString();
+    m_builder.clear();
+    return script.isNull() ? emptyString() : WTFMove(script);
+}
+
+void CachedScriptStreamingDecoder::cancel()
+{
+    ASSERT(isMainThread());
+    auto locker = holdLock(m_lock);
+    m_isCancelled = true;
+    m_queuedSegments.clear();
+    m_pendingASCIISegments.clear();
+}
+
 CachedScript::CachedScript(CachedResourceRequest&& request, const PAL::SessionID& sessionID, const CookieJar* cookieJar)
     : CachedResource(WTFMove(request), Type::Script, sessionID, cookieJar)
     , m_decoder(TextResourceDecoder::create("text/javascript"_s, request.charset()))
@@ -47,6 +198,14 @@ CachedScript::~CachedScript() = default;
 void CachedScript::setEncoding(const String& chs)
 {
     m_decoder->setEncoding(chs, TextResourceDecoder::EncodingFromHTTPHeader);
+    // Anything decoded so far used the previous encoding.
+    cancelStreamingDecoder();
+}
+
+void CachedScript::cancelStreamingDecoder()
+{
+    if (auto streamingDecoder = std::exchange(m_streamingDecoder, nullptr))
+        streamingDecoder->cancel();
 }
 
 String CachedScript::encoding() const
@@ -54,6 +213,15 @@ String CachedScript::encoding() const
     return m_decoder->encoding().name();
 }
 
+static bool isAllASCII(const SharedBuffer& data)
+{
+    for (const auto& element : data) {
+        if (!charactersAreAllASCII(reinterpret_cast<const LChar*>(element.segment->data()), element.segment->size()))
+            return false;
+    }
+    return true;
+}
+
 StringView CachedScript::script()
 {
     if (!m_data)
@@ -62,7 +230,7 @@ StringView CachedScript::script()
     if (m_decodingState == NeverDecoded
         && TextEncoding(encoding()).isByteBasedEncoding()
         && m_data->size()
-        && charactersAreAllASCII(reinterpret_cast<const LChar*>(m_data->data()), m_data->size())) {
+        && isAllASCII(*m_data)) {
 
         m_decodingState = DataAndDecodedStringHaveSameBytes;
 
@@ -73,22 +241,27 @@ StringView CachedScript::script()
         m_scriptHash = StringHasher::computeHashAndMaskTop8Bits(reinterpret_cast<const LChar*>(m_data->data()), m_data->size());
     }
 
+    // Only a script whose bytes are used as is needs them in one segment.
     if (m_decodingState == DataAndDecodedStringHaveSameBytes)
         return { reinterpret_cast<const LChar*>(m_data->data()), static_cast<unsigned>(m_data->size()) };
 
-    if (!m_script) {
-        m_script = m_decoder->decodeAndFlush(m_data->data(), encodedSize());
-        ASSERT(!m_scriptHash || m_scriptHash == m_script.impl()->hash());
-        if (m_decodingState == NeverDecoded)
-            m_scriptHash = m_script.impl()->hash();
-        m_decodingState = DataAndDecodedStringHaveDifferentBytes;
-        setDecodedSize(m_script.sizeInBytes());
-    }
+    if (!m_script)
+        setDecodedScript(m_decoder->decodeAndFlush(*m_data));
 
     m_decodedDataDeletionTimer.restart();
     return m_script;
 }
 
+void CachedScript::setDecodedScript(String&& script)
+{
+    m_script = WTFMove(script);
+    ASSERT(!m_scriptHash || m_scriptHash == m_script.impl()->hash());
+    if (m_decodingState == NeverDecoded)
+        m_scriptHash = m_script.impl()->hash();
+    m_decodingState = DataAndDecodedStringHaveDifferentBytes;
+    setDecodedSize(m_script.sizeInBytes());
+}
+
 unsigned CachedScript::scriptHash()
 {
     if (m_decodingState == NeverDecoded)
@@ -96,15 +269,43 @@ unsigned CachedScript::scriptHash()
     return m_scriptHash;
 }
 
+void CachedScript::updateBuffer(SharedBuffer& data)
+{
+    CachedResource::updateBuffer(data);
+
+    if (m_decodingState != NeverDecoded)
+        return;
+
+    if (!m_streamingDecoder || m_streamingDecoder->receivedSize() > data.size()) {
+        cancelStreamingDecoder();
+        m_streamingDecoder = CachedScriptStreamingDecoder::create(m_decoder->encoding());
+    }
+    m_streamingDecoder->append(data);
+}
+
 void CachedScript::finishLoading(SharedBuffer* data, const NetworkLoadMetrics& metrics)
 {
     m_data = data;
     setEncodedSize(data ? data->size() : 0);
+
+    if (auto streamingDecoder = std::exchange(m_streamingDecoder, nullptr)) {
+        // Parser-blocking scripts run as soon as this returns, so the decoded script is needed now.
+        if (data && m_decodingState == NeverDecoded && streamingDecoder->receivedSize() <= data->size()) {
+            if (auto script = streamingDecoder->finish(*data)) {
+                m_decoder = &streamingDecoder->decoder();
+                setDecodedScript(WTFMove(*script));
+                m_decodedDataDeletionTimer.restart();
+            }
+        } else
+            streamingDecoder->cancel();
+    }
+
     CachedResource::finishLoading(data, metrics);
 }
 
 void CachedScript::destroyDecodedData()
 {
+    cancelStreamingDecoder();
     m_script = String();
     setDecodedSize(0);
 }
@@ -120,6 +321,7 @@ void CachedScript::setBodyDataFrom(const CachedResource& resource)
     m_scriptHash = script.m_scriptHash;
     m_decodingState = script.m_decodingState;
     m_decoder = script.m_decoder;
+    cancelStreamingDecoder();
 }
 
 bool CachedScript::shouldIgnoreHTTPStatusCodeErrors() const
@@ -29,6 +29,7 @@
 
 namespace WebCore {
 
+class CachedScriptStreamingDecoder;
 class TextResourceDecoder;
 
 class CachedScript final : public CachedResource {
@@ -47,12 +48,16 @@ private:
     void setEncoding(const String&) final;
     String encoding() const final;
     const TextResourceDecoder* textResourceDecoder() const final { return m_decoder.get(); }
+    void updateBuffer(SharedBuffer&) final;
     void finishLoading(SharedBuffer*, const NetworkLoadMetrics&) final;
 
     void destroyDecodedData() final;
 
     void setBodyDataFrom(const CachedResource&) final;
 
+    void setDecodedScript(String&&);
+    void cancelStreamingDecoder();
+
     String m_script;
     unsigned m_scriptHash { 0 };
 
@@ -60,6 +65,7 @@ private:
     DecodingState m_decodingState { NeverDecoded };
 
     RefPtr<TextResourceDecoder> m_decoder;
+    RefPtr<CachedScriptStreamingDecoder> m_streamingDecoder;
 };
 
 } // namespace WebCore
@@ -66,7 +66,7 @@ void CachedXSLStyleSheet::finishLoading(SharedBuffer* data, const NetworkLoadMet
     m_data = data;
     setEncodedSize(data ? data->size() : 0);
     if (data)
-        m_sheet = m_decoder->decodeAndFlush(data->data(), encodedSize());
+        m_sheet = m_decoder->decodeAndFlush(*data);
     setLoading(false);
     checkNotify(metrics);
 }
@@ -42,6 +42,7 @@
 #include <pal/Logging.h>
 #include <stdio.h>
 #include <wtf/MathExtras.h>
+#include <wtf/StdLibExtras.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/SetForScope.h>
 #include <wtf/text/CString.h>
@@ -52,6 +53,12 @@ static const int cDefaultCacheCapacity = 8192 * 1024;
 static const Seconds cMinDelayBeforeLiveDecodedPrune { 1_s };
 static const float cTargetPrunePercentage = .95f; // Percentage of capacity toward which we prune, to avoid immediately pruning again.
 
+// Indexed by MemoryCache::ResourceCategory.
+static const double cDefaultDeadCapacityFractions[] = { .5, .2, .15, .1, .05 };
+// How much more it costs to load a resource of each category again, per byte, relative to an image.
+// Scripts and style sheets block parsing or rendering and have to be parsed again.
+static const double cReloadCostWeights[] = { 1, 4, 4, 2, 1 };
+
 MemoryCache& MemoryCache::singleton()
 {
     ASSERT(WTF::isMainThread());
@@ -65,6 +72,11 @@ MemoryCache::MemoryCache()
     , m_pruneTimer(*this, &MemoryCache::prune)
 {
     static_assert(sizeof(long long) > sizeof(unsigned), "Numerical overflow can happen when adjusting the size of the cached memory.");
+    static_assert(WTF_ARRAY_LENGTH(cDefaultDeadCapacityFractions) == resourceCategoryCount, "Every resource category needs a default dead capacity fraction.");
+    static_assert(WTF_ARRAY_LENGTH(cReloadCostWeights) == resourceCategoryCount, "Every resource category needs a reload cost weight.");
+
+    for (unsigned i = 0; i < resourceCategoryCount; ++i)
+        m_categories[i].deadCapacityFraction = cDefaultDeadCapacityFractions[i];
 
     static std::once_flag onceFlag;
     std::call_once(onceFlag, [] {
@@ -154,7 +166,7 @@ void MemoryCache::revalidationSucceeded(CachedResource& revalidatingResource, co
     if (resource.decodedSize() && resource.hasClients())
         insertInLiveDecodedResourcesList(resource);
     if (delta)
-        adjustSize(resource.hasClients(), delta);
+        adjustSize(resource, resource.hasClients(), delta);
 
     revalidatingResource.switchClientsToRevalidatedResource();
     ASSERT(!revalidatingResource.m_deleted);
@@ -322,6 +334,12 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
     if (targetSize && m_deadSize <= targetSize)
         return;
 
+    if (targetSize) {
+        pruneDeadResourcesOverCategoryCapacity(targetSize);
+        if (m_deadSize <= targetSize)
+            return;
+    }
+
     bool canShrinkLRULists = true;
     for (int i = m_allResources.size() - 1; i >= 0; i--) {
         // Make a copy of the LRUList first (and ref the resources) as calling
@@ -361,6 +379,7 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
                 continue;
 
             if (!resource->hasClients() && !resource->isPreloaded() && !resource->isCacheValidator()) {
+                ++categoryFor(*resource).statistics.evictionCount;
                 remove(*resource);
                 if (targetSize && m_deadSize <= targetSize)
                     return;
@@ -376,6 +395,66 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
     }
 }
 
+void MemoryCache::pruneDeadResourcesOverCategoryCapacity(unsigned targetSize)
+{
+    ASSERT(m_inPruneResources);
+
+    for (unsigned i = 0; i < resourceCategoryCount; ++i) {
+        auto& category = m_categories[i];
+        unsigned capacity = static_cast<unsigned>(targetSize * category.deadCapacityFraction);
+        if (category.statistics.deadSize <= capacity)
+            continue;
+
+        LOG(ResourceLoading, " category %s over capacity (dead size %u, capacity %u)", categoryName(static_cast<ResourceCategory>(i)), category.statistics.deadSize, capacity);
+
+        Vector<std::pair<double, CachedResource*>> candidates;
+        for (auto& lruList : m_allResources) {
+            for (auto* resource : *lruList) {
+                if (static_cast<unsigned>(categoryForType(resource->type())) != i)
+                    continue;
+                if (resource->inCache() && !resource->hasClients() && !resource->isPreloaded())
+                    candidates.append({ retentionScore(*resource), resource });
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](auto& a, auto& b) {
+            return a.first < b.first;
+        });
+
+        // First flush decoded data, which is cheaper to bring back than encoded data.
+        for (auto& candidate : candidates) {
+            auto& resource = *candidate.second;
+            if (!resource.inCache() || !resource.isLoaded())
+                continue;
+            resource.destroyDecodedData();
+            if (m_deadSize <= targetSize)
+                return;
+            if (category.statistics.deadSize <= capacity)
+                break;
+        }
+
+        for (auto& candidate : candidates) {
+            if (category.statistics.deadSize <= capacity)
+                break;
+            auto& resource = *candidate.second;
+            if (!resource.inCache() || resource.isCacheValidator())
+                continue;
+            ++category.statistics.evictionCount;
+            remove(resource);
+            if (m_deadSize <= targetSize)
+                return;
+        }
+    }
+}
+
+// Higher scores are kept longer. This weighs how often a resource is requested and how costly it is
+// to load again against the space it takes.
+double MemoryCache::retentionScore(CachedResource& resource) const
+{
+    double weight = cReloadCostWeights[static_cast<unsigned>(categoryForType(resource.type()))];
+    double frequency = 1 + resource.accessCount() + m_frequencySketch.frequency(resource.url().string().hash());
+    return weight * frequency / std::max(resource.size(), 1U);
+}
+
 void MemoryCache::setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes)
 {
     ASSERT(minDeadBytes <= maxDeadBytes);
@@ -386,6 +465,12 @@ void MemoryCache::setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, un
     prune();
 }
 
+void MemoryCache::setDeadCapacityFraction(ResourceCategory category, double fraction)
+{
+    ASSERT(fraction >= 0 && fraction <= 1);
+    m_categories[static_cast<unsigned>(category)].deadCapacityFraction = fraction;
+}
+
 void MemoryCache::remove(CachedResource& resource)
 {
     ASSERT(WTF::isMainThread());
@@ -409,7 +494,7 @@ void MemoryCache::remove(CachedResource& resource)
             // Remove from the appropriate LRU list.
             removeFromLRUList(resource);
             removeFromLiveDecodedResourcesList(resource);
-            adjustSize(resource.hasClients(), -static_cast<long long>(resource.size()));
+            adjustSize(resource, resource.hasClients(), -static_cast<long long>(resource.size()));
         } else {
             ASSERT(resources->get(key) != &resource);
             LOG(ResourceLoading, "  resource %p is not in cache", &resource);
@@ -471,7 +556,7 @@ void MemoryCache::resourceAccessed(CachedResource& resource)
     
     // If this is the first time the resource has been accessed, adjust the size of the cache to account for its initial size.
     if (!resource.accessCount())
-        adjustSize(resource.hasClients(), resource.size());
+        adjustSize(resource, resource.hasClients(), resource.size());
     
     // Add to our access count.
     resource.increaseAccessCount();
@@ -579,22 +664,33 @@ void MemoryCache::addToLiveResourcesSize(CachedResource& resource)
 {
     m_liveSize += resource.size();
     m_deadSize -= resource.size();
+
+    auto& statistics = categoryFor(resource).statistics;
+    statistics.liveSize += resource.size();
+    statistics.deadSize -= resource.size();
 }
 
 void MemoryCache::removeFromLiveResourcesSize(CachedResource& resource)
 {
     m_liveSize -= resource.size();
     m_deadSize += resource.size();
+
+    auto& statistics = categoryFor(resource).statistics;
+    statistics.liveSize -= resource.size();
+    statistics.deadSize += resource.size();
 }
 
-void MemoryCache::adjustSize(bool live, long long delta)
+void MemoryCache::adjustSize(CachedResource& resource, bool live, long long delta)
 {
+    auto& statistics = categoryFor(resource).statistics;
     if (live) {
         ASSERT(delta >= 0 || (static_cast<long long>(m_liveSize) + delta >= 0));
         m_liveSize += delta;
+        statistics.liveSize += delta;
     } else {
         ASSERT(delta >= 0 || (static_cast<long long>(m_deadSize) + delta >= 0));
         m_deadSize += delta;
+        statistics.deadSize += delta;
     }
 }
 
@@ -655,6 +751,108 @@ MemoryCache::Statistics MemoryCache::getStatistics()
     return stats;
 }
 
+auto MemoryCache::categoryForType(CachedResource::Type type) -> ResourceCategory
+{
+    switch (type) {
+    case CachedResource::Type::ImageResource:
+        return ResourceCategory::Image;
+    case CachedResource::Type::Script:
+        return ResourceCategory::Script;
+    case CachedResource::Type::CSSStyleSheet:
+#if ENABLE(XSLT)
+    case CachedResource::Type::XSLStyleSheet:
+#endif
+        return ResourceCategory::StyleSheet;
+    case CachedResource::Type::FontResource:
+    case CachedResource::Type::SVGFontResource:
+        return ResourceCategory::Font;
+    default:
+        return ResourceCategory::Other;
+    }
+}
+
+const char* MemoryCache::categoryName(ResourceCategory category)
+{
+    switch (category) {
+    case ResourceCategory::Image:
+        return "Images";
+    case ResourceCategory::Script:
+        return "JavaScript";
+    case ResourceCategory::StyleSheet:
+        return "Style sheets";
+    case ResourceCategory::Font:
+        return "Fonts";
+    case ResourceCategory::Other:
+        return "Other";
+    }
+    ASSERT_NOT_REACHED();
+    return "";
+}
+
+auto MemoryCache::categoryStatistics(ResourceCategory category) const -> CategoryStatistics
+{
+    auto& state = m_categories[static_cast<unsigned>(category)];
+    auto statistics = state.statistics;
+    statistics.deadCapacity = static_cast<unsigned>(deadCapacity() * state.deadCapacityFraction);
+    return statistics;
+}
+
+void MemoryCache::resetCategoryStatistics()
+{
+    for (auto& category : m_categories) {
+        category.statistics.hitCount = 0;
+        category.statistics.missCount = 0;
+        category.statistics.evictionCount = 0;
+    }
+}
+
+void MemoryCache::resourceRequested(CachedResource::Type type, const URL& url, bool usedCachedResource)
+{
+    auto& statistics = m_categories[static_cast<unsigned>(categoryForType(type))].statistics;
+    if (usedCachedResource)
+        ++statistics.hitCount;
+    else
+        ++statistics.missCount;
+
+    m_frequencySketch.record(removeFragmentIdentifierIfNeeded(url).string().hash());
+}
+
+unsigned MemoryCache::FrequencySketch::index(unsigned hash, unsigned i)
+{
+    static_assert(counterCount == 1 << 12, "The index is taken from the top 12 bits of the product below.");
+    static const unsigned multipliers[hashCount] = { 0x97cb3127, 0xab7b5f35, 0x6c3e4d1b, 0x2f6a5b93 };
+    return ((hash ^ (hash >> 15)) * multipliers[i]) >> 20;
+}
+
+unsigned MemoryCache::FrequencySketch::frequency(unsigned hash) const
+{
+    unsigned frequency = maximumFrequency;
+    for (unsigned i = 0; i < hashCount; ++i)
+        frequency = std::min<unsigned>(frequency, m_counters[index(hash, i)]);
+    return frequency;
+}
+
+void MemoryCache::FrequencySketch::record(unsigned hash)
+{
+    unsigned frequency = this->frequency(hash);
+    if (frequency < maximumFrequency) {
+        // Only raise the counters holding the minimum, so that collisions inflate counts less.
+        for (unsigned i = 0; i < hashCount; ++i) {
+            auto& counter = m_counters[index(hash, i)];
+            if (counter == frequency)
+                ++counter;
+        }
+    }
+
+    if (++m_additionCount < sampleSize)
+        return;
+
+    // Halve every count so that resources which stopped being requested lose their protection.
+    for (auto& counter : m_counters)
+        counter >>= 1;
+    m_additionCount /= 2;
+}
+
 void MemoryCache::setDisabled(bool disabled)
 {
     m_disabled = disabled;
@@ -737,6 +935,13 @@ void MemoryCache::dumpStats()
 #endif
 
     WTFLogAlways("%-13s %13d %11.2fKB %11.2fKB %11.2fKB\n", "Total", countTotal, sizeTotal / 1024., liveSizeTotal / 1024., decodedSizeTotal / 1024.);
+
+    WTFLogAlways("\n%-13s %-13s %-13s %-13s %-13s %-13s\n", "", "Hits", "Misses", "Evictions", "DeadSize", "DeadCapacity");
+    for (unsigned i = 0; i < resourceCategoryCount; ++i) {
+        auto category = static_cast<ResourceCategory>(i);
+        auto statistics = categoryStatistics(category);
+        WTFLogAlways("%-13s %13u %13u %13u %13u %13u\n", categoryName(category), statistics.hitCount, statistics.missCount, statistics.evictionCount, statistics.deadSize, statistics.deadCapacity);
+    }
 }
 
 void MemoryCache::dumpLRULists(bool includeLive) const
@@ -24,8 +24,10 @@
 
 #pragma once
 
+#include "CachedResource.h"
 #include "SecurityOriginHash.h"
 #include "Timer.h"
+#include <array>
 #include <pal/SessionID.h>
 #include <wtf/Forward.h>
 #include <wtf/Function.h>
@@ -39,7 +41,6 @@
 
 namespace WebCore  {
 
-class CachedResource;
 class CookieJar;
 class ResourceRequest;
 class ResourceResponse;
@@ -59,6 +60,10 @@ class SecurityOrigin;
 // -------|-----+++++++++++++++|
 // -------|-----+++++++++++++++|+++++
 
+// When dead resources have to be pruned, resource categories that use more than their share of the
+// dead capacity are pruned first. Within such a category, resources that are large, cheap to fetch
+// and decode again, and rarely requested go first.
+
 class MemoryCache {
     WTF_MAKE_NONCOPYABLE(MemoryCache); WTF_MAKE_FAST_ALLOCATED;
     friend NeverDestroyed<MemoryCache>;
@@ -89,6 +94,20 @@ public:
         TypeStatistic fonts;
     };
 
+    enum class ResourceCategory : uint8_t { Image, Script, StyleSheet, Font, Other };
+    static constexpr unsigned resourceCategoryCount = 5;
+    static ResourceCategory categoryForType(CachedResource::Type);
+    static const char* categoryName(ResourceCategory);
+
+    struct CategoryStatistics {
+        unsigned hitCount { 0 };
+        unsigned missCount { 0 };
+        unsigned evictionCount { 0 };
+        unsigned liveSize { 0 };
+        unsigned deadSize { 0 };
+        unsigned deadCapacity { 0 };
+    };
+
     WEBCORE_EXPORT static MemoryCache& singleton();
 
     WEBCORE_EXPORT CachedResource* resourceForRequest(const ResourceRequest&, PAL::SessionID);
@@ -113,6 +132,10 @@ public:
     //  - totalBytes: The maximum number of bytes that the cache should consume overall.
     WEBCORE_EXPORT void setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes);
 
+    // Sets the share of the dead capacity that dead resources of a category can use before they are
+    // pruned ahead of other categories. The shares do not limit a category while there is room to spare.
+    WEBCORE_EXPORT void setDeadCapacityFraction(ResourceCategory, double);
+
     // Turn the cache on and off.  Disabling the cache will remove all resources from the cache.  They may
     // still live on if they are referenced by some Web page though.
     WEBCORE_EXPORT void setDisabled(bool);
@@ -133,7 +156,7 @@ public:
     void removeFromLRUList(CachedResource&);
 
     // Called to adjust the cache totals when a resource changes size.
-    void adjustSize(bool live, long long delta);
+    void adjustSize(CachedResource&, bool live, long long delta);
 
     // Track decoded resources that are in the cache and referenced by a Web page.
     void insertInLiveDecodedResourcesList(CachedResource&);
@@ -146,7 +169,13 @@ public:
 
     // Function to collect cache statistics for the caches window in the Safari Debug menu.
     WEBCORE_EXPORT Statistics getStatistics();
-    
+
+    WEBCORE_EXPORT CategoryStatistics categoryStatistics(ResourceCategory) const;
+    WEBCORE_EXPORT void resetCategoryStatistics();
+
+    // Called by CachedResourceLoader for every cacheable request, whether or not it was served from this cache.
+    void resourceRequested(CachedResource::Type, const URL&, bool usedCachedResource);
+
     void resourceAccessed(CachedResource&);
     bool inLiveDecodedResourcesList(CachedResource& resource) const { return m_liveDecodedResources.contains(&resource); }
 
@@ -180,6 +209,9 @@ private:
     unsigned deadCapacity() const;
     bool needsPruning() const;
 
+    void pruneDeadResourcesOverCategoryCapacity(unsigned targetSize);
+    double retentionScore(CachedResource&) const;
+
     CachedResource* resourceForRequestImpl(const ResourceRequest&, CachedResourceMap&);
 
     CachedResourceMap& ensureSessionResourceMap(PAL::SessionID);
@@ -196,6 +228,34 @@ private:
     unsigned m_liveSize { 0 }; // The number of bytes currently consumed by "live" resources in the cache.
     unsigned m_deadSize { 0 }; // The number of bytes currently consumed by "dead" resources in the cache.
 
+    struct Category {
+        CategoryStatistics statistics;
+        double deadCapacityFraction;
+    };
+    std::array<Category, resourceCategoryCount> m_categories;
+    Category& categoryFor(CachedResource& resource) { return m_categories[static_cast<unsigned>(categoryForType(resource.type()))]; }
+
+    // Approximate request counts per URL that age over time, kept in a count-min sketch with small
+    // saturating counters. Unlike CachedResource::accessCount(), they survive the resource being
+    // evicted and loaded again.
+    class FrequencySketch {
+    public:
+        void record(unsigned hash);
+        unsigned frequency(unsigned hash) const;
+
+    private:
+        static constexpr unsigned counterCount = 4096;
+        static constexpr unsigned hashCount = 4;
+        static constexpr uint8_t maximumFrequency = 15;
+        static constexpr unsigned sampleSize = 10 * counterCount;
+
+        static unsigned index(unsigned hash, unsigned i);
+
+        std::array<uint8_t, counterCount> m_counters { };
+        unsigned m_additionCount { 0 };
+    };
+    FrequencySketch m_frequencySketch;
+
     // Size-adjusted and popularity-aware LRU list collection for cache objects.  This collection can hold
     // more resources than the cached resource map, since it can also hold "stale" multiple versions of objects that are
     // waiting to die when the clients referencing them go away.
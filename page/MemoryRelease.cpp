@@ -34,6 +34,7 @@
 #include "ChromeClient.h"
 #include "CommonVM.h"
 #include "CookieJar.h"
+#include "DecodedImageFrameCache.h"
 #include "Document.h"
 #include "FontCache.h"
 #include "Frame.h"
@@ -60,6 +61,10 @@
 #include "ResourceUsageThread.h"
 #endif
 
+#if USE(HARFBUZZ)
+#include "ComplexTextRunCache.h"
+#endif
+
 namespace WebCore {
 
 static void releaseNoncriticalMemory(MaintainMemoryCache maintainMemoryCache)
@@ -69,7 +74,11 @@ static void releaseNoncriticalMemory(MaintainMemoryCache maintainMemoryCache)
     FontCache::singleton().purgeInactiveFontData();
 
     clearWidthCaches();
+#if USE(HARFBUZZ)
+    ComplexTextRunCache::singleton().clear();
+#endif
     TextPainter::clearGlyphDisplayLists();
+    DecodedImageFrameCache::singleton().prune();
 
     for (auto* document : Document::allDocuments()) {
         document->clearSelectorQueryCache();
@@ -100,6 +109,7 @@ static void releaseCriticalMemory(Synchronous synchronous, MaintainBackForwardCa
     }
 
     CSSValuePool::singleton().drain();
+    DecodedImageFrameCache::singleton().clear();
 
     Page::forEachPage([](auto& page) {
         page.cookieJar().clearCache();
@@ -208,6 +218,14 @@ void logMemoryStatisticsAtTimeOfDeath()
     auto typeCounts = vm.heap.objectTypeCounts();
     for (auto& it : *typeCounts)
         RELEASE_LOG(MemoryPressure, "  %s: %d", it.key, it.value);
+
+    auto& memoryCache = MemoryCache::singleton();
+    RELEASE_LOG(MemoryPressure, "Memory cache size: %u", memoryCache.size());
+    for (unsigned i = 0; i < MemoryCache::resourceCategoryCount; ++i) {
+        auto category = static_cast<MemoryCache::ResourceCategory>(i);
+        auto statistics = memoryCache.categoryStatistics(category);
+        RELEASE_LOG(MemoryPressure, "  %s: live %u, dead %u (capacity %u), hits %u, misses %u, evictions %u", MemoryCache::categoryName(category), statistics.liveSize, statistics.deadSize, statistics.deadCapacity, statistics.hitCount, statistics.missCount, statistics.evictionCount);
+    }
 #endif
 }
 
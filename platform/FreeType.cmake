@@ -11,17 +11,21 @@ list(APPEND WebCore_SOURCES
     platform/graphics/freetype/FontCustomPlatformDataFreeType.cpp
     platform/graphics/freetype/FontPlatformDataFreeType.cpp
     platform/graphics/freetype/GlyphPageTreeNodeFreeType.cpp
+    platform/graphics/freetype/PersistentFontFallbackCache.cpp
     platform/graphics/freetype/RefPtrFontconfig.cpp
     platform/graphics/freetype/SimpleFontDataFreeType.cpp
 
     platform/graphics/harfbuzz/ComplexTextControllerHarfBuzz.cpp
+    platform/graphics/harfbuzz/ComplexTextRunCache.cpp
     platform/graphics/harfbuzz/FontDescriptionHarfBuzz.cpp
 )
 
 list(APPEND WebCore_PRIVATE_FRAMEWORK_HEADERS
     platform/graphics/freetype/FcUniquePtr.h
+    platform/graphics/freetype/PersistentFontFallbackCache.h
     platform/graphics/freetype/RefPtrFontconfig.h
 
+    platform/graphics/harfbuzz/ComplexTextRunCache.h
     platform/graphics/harfbuzz/HbUniquePtr.h
 )
 
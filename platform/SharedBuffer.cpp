@@ -29,6 +29,7 @@
 #include "SharedBuffer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <wtf/HexNumber.h>
 #include <wtf/persistence/PersistentCoders.h>
 #include <wtf/text/StringBuilder.h>
@@ -92,6 +93,18 @@ Ref<SharedBuffer> SharedBuffer::create(Vector<uint8_t>&& vector)
     return adoptRef(*new SharedBuffer { vector.data(), vector.size() });
 }
 
+static std::atomic<uint64_t> s_bytesCopiedByCombiningSegments;
+
+uint64_t SharedBuffer::bytesCopiedByCombiningSegments()
+{
+    return s_bytesCopiedByCombiningSegments.load(std::memory_order_relaxed);
+}
+
+void SharedBuffer::resetBytesCopiedByCombiningSegments()
+{
+    s_bytesCopiedByCombiningSegments.store(0, std::memory_order_relaxed);
+}
+
 void SharedBuffer::combineIntoOneSegment() const
 {
 #if ASSERT_ENABLED
@@ -107,6 +120,7 @@ void SharedBuffer::combineIntoOneSegment() const
     for (const auto& segment : m_segments)
         combinedData.append(segment.segment->data(), segment.segment->size());
     ASSERT(combinedData.size() == m_size);
+    s_bytesCopiedByCombiningSegments.fetch_add(m_size, std::memory_order_relaxed);
     m_segments.clear();
     m_segments.append({0, DataSegment::create(WTFMove(combinedData))});
     ASSERT(m_segments.size() == 1);
@@ -138,6 +152,36 @@ SharedBufferDataView SharedBuffer::getSomeData(size_t position) const
     return { element->segment.copyRef(), position - element->beginPosition };
 }
 
+SharedBufferSegmentReader::SharedBufferSegmentReader(const SharedBuffer& buffer)
+    : m_size(buffer.size())
+{
+    m_segments.reserveInitialCapacity(buffer.end() - buffer.begin());
+    for (const auto& element : buffer)
+        m_segments.uncheckedAppend({ element.beginPosition, element.segment.copyRef() });
+}
+
+size_t SharedBufferSegmentReader::segmentIndexForPosition(size_t position) const
+{
+    ASSERT(position < m_size);
+    auto comparator = [](const size_t& position, const SharedBuffer::DataSegmentVectorEntry& entry) {
+        return position < entry.beginPosition;
+    };
+    auto* element = std::upper_bound(m_segments.begin(), m_segments.end(), position, comparator);
+    return element - m_segments.begin() - 1;
+}
+
+size_t SharedBufferSegmentReader::copyTo(char* destination, size_t position, size_t length) const
+{
+    size_t bytesCopied = 0;
+    forEachSegment(position, [&](const char* data, size_t segmentLength) {
+        size_t bytesToCopy = std::min(segmentLength, length - bytesCopied);
+        memcpy(destination + bytesCopied, data, bytesToCopy);
+        bytesCopied += bytesToCopy;
+        return bytesCopied < length;
+    });
+    return bytesCopied;
+}
+
 String SharedBuffer::toHexString() const
 {
     StringBuilder stringBuilder;
@@ -108,6 +108,12 @@ public:
     const char* data() const;
     const uint8_t* dataAsUInt8Ptr() const;
 
+    bool hasOneSegment() const { return m_segments.size() == 1; }
+
+    // Total number of bytes copied by data() when combining segments, across all SharedBuffers.
+    static uint64_t bytesCopiedByCombiningSegments();
+    static void resetBytesCopiedByCombiningSegments();
+
     // Creates an ArrayBuffer and copies this SharedBuffer's contents to that
     // ArrayBuffer without merging segmented buffers into a flat buffer.
     RefPtr<ArrayBuffer> tryCreateArrayBuffer() const;
@@ -256,6 +262,43 @@ inline bool operator!=(const Ref<SharedBuffer>& left, const SharedBuffer& right)
     return left.get() != right;
 }
 
+// A snapshot of the segments of a SharedBuffer. Unlike the SharedBuffer itself, it can be
+// handed to a decoding thread, and it lets decoders walk the data without calling data().
+class WEBCORE_EXPORT SharedBufferSegmentReader {
+public:
+    SharedBufferSegmentReader() = default;
+    explicit SharedBufferSegmentReader(const SharedBuffer&);
+
+    size_t size() const { return m_size; }
+    bool isEmpty() const { return !m_size; }
+
+    // Calls functor(const char* data, size_t length) for each contiguous range of bytes from
+    // position to the end of the data, until the functor returns false.
+    template<typename Functor> void forEachSegment(size_t position, const Functor&) const;
+
+    // Copies up to length bytes starting at position. Returns the number of bytes copied.
+    size_t copyTo(char* destination, size_t position, size_t length) const;
+
+private:
+    size_t segmentIndexForPosition(size_t) const;
+
+    Vector<SharedBuffer::DataSegmentVectorEntry, 1> m_segments;
+    size_t m_size { 0 };
+};
+
+template<typename Functor>
+void SharedBufferSegmentReader::forEachSegment(size_t position, const Functor& functor) const
+{
+    if (position >= m_size)
+        return;
+    for (size_t index = segmentIndexForPosition(position); index < m_segments.size(); ++index) {
+        auto& entry = m_segments[index];
+        size_t offset = position > entry.beginPosition ? position - entry.beginPosition : 0;
+        if (!functor(entry.segment->data() + offset, entry.segment->size() - offset))
+            return;
+    }
+}
+
 class WEBCORE_EXPORT SharedBufferDataView {
 public:
     SharedBufferDataView(Ref<SharedBuffer::DataSegment>&&, size_t);
@@ -36,6 +36,7 @@
 #include "Logging.h"
 #include "Settings.h"
 #include "Timer.h"
+#include <wtf/MemoryPressureHandler.h>
 #include <wtf/Vector.h>
 #include <wtf/text/TextStream.h>
 #include <wtf/text/WTFString.h>
@@ -413,6 +414,9 @@ SubsamplingLevel BitmapImage::subsamplingLevelForScaleFactor(GraphicsContext& co
     // Never use subsampled images for drawing into PDF contexts.
     if (context.hasPlatformContext() && CGContextGetType(context.platformContext()) == kCGContextTypePDF)
         return SubsamplingLevel::Default;
+#else
+    UNUSED_PARAM(context);
+#endif
 
     float scale = std::min(float(1), std::max(scaleFactor.width(), scaleFactor.height()));
     if (!(scale > 0 && scale <= 1))
@@ -420,11 +424,6 @@ SubsamplingLevel BitmapImage::subsamplingLevelForScaleFactor(GraphicsContext& co
 
     int result = std::ceil(std::log2(1 / scale));
     return static_cast<SubsamplingLevel>(std::min(result, static_cast<int>(m_source->maximumSubsamplingLevel())));
-#else
-    UNUSED_PARAM(context);
-    UNUSED_PARAM(scaleFactor);
-    return SubsamplingLevel::Default;
-#endif
 }
 
 bool BitmapImage::canDestroyDecodedData()
@@ -450,9 +449,10 @@ BitmapImage::StartAnimationStatus BitmapImage::internalStartAnimation()
     if (m_frameTimer)
         return StartAnimationStatus::TimerActive;
 
-    // Don't start a new animation until we draw the frame that is currently being decoded.
+    // Don't start a new animation until we draw the frame that is currently being decoded. A frame
+    // which was requested ahead of time still gets its timer, unless that timer has already fired.
     size_t nextFrame = (m_currentFrame + 1) % frameCount();
-    if (frameIsBeingDecodedAndIsCompatibleWithOptionsAtIndex(nextFrame, DecodingOptions(DecodingMode::Asynchronous))) {
+    if (m_nextFrameIsLate && frameIsBeingDecodedAndIsCompatibleWithOptionsAtIndex(nextFrame, DecodingOptions(DecodingMode::Asynchronous))) {
         LOG(Images, "BitmapImage::%s - %p - url: %s [nextFrame = %ld is being decoded]", __FUNCTION__, this, sourceURL().string().utf8().data(), nextFrame);
         return StartAnimationStatus::DecodingActive;
     }
@@ -477,12 +477,31 @@ BitmapImage::StartAnimationStatus BitmapImage::internalStartAnimation()
         destroyDecodedDataIfNecessary(true);
     }
 
+    MonotonicTime time = MonotonicTime::now();
+
+    // When decoding fell behind the animation, drop the frames whose display time has
+    // already passed, provided the frames on both sides were decoded ahead.
+    if (m_desiredFrameStartTime && shouldUseAsyncDecodingForAnimatedImages()) {
+        while (nextFrame < frameCount() - 1) {
+            size_t frameAfterNextFrame = nextFrame + 1;
+            if (time < m_desiredFrameStartTime + Seconds { frameDurationAtIndex(m_currentFrame) } + Seconds { frameDurationAtIndex(nextFrame) })
+                break;
+            if (!frameHasDecodedNativeImageCompatibleWithOptionsAtIndex(nextFrame, m_currentSubsamplingLevel, DecodingOptions(Optional<IntSize>()))
+                || !frameHasDecodedNativeImageCompatibleWithOptionsAtIndex(frameAfterNextFrame, m_currentSubsamplingLevel, DecodingOptions(Optional<IntSize>())))
+                break;
+
+            m_desiredFrameStartTime += Seconds { frameDurationAtIndex(m_currentFrame) };
+            m_currentFrame = nextFrame;
+            nextFrame = frameAfterNextFrame;
+            ++m_skippedFrameCount;
+            LOG(Images, "BitmapImage::%s - %p - url: %s [skippedFrameCount = %u nextFrame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), m_skippedFrameCount, nextFrame);
+        }
+    }
+
     // Don't advance the animation to an incomplete frame.
     if (!m_source->isAllDataReceived() && !frameIsCompleteAtIndex(nextFrame))
         return StartAnimationStatus::IncompleteData;
 
-    MonotonicTime time = MonotonicTime::now();
-
     // Handle initial state.
     if (!m_desiredFrameStartTime)
         m_desiredFrameStartTime = time;
@@ -495,14 +514,19 @@ BitmapImage::StartAnimationStatus BitmapImage::internalStartAnimation()
     // through the callback newFrameNativeImageAvailableAtIndex(). Otherwise, advanceAnimation() will be called
     // when the timer fires and m_currentFrame will be advanced to nextFrame since it is not being decoded.
     if (shouldUseAsyncDecodingForAnimatedImages()) {
-        if (frameHasDecodedNativeImageCompatibleWithOptionsAtIndex(nextFrame, m_currentSubsamplingLevel, DecodingOptions(Optional<IntSize>())))
-            LOG(Images, "BitmapImage::%s - %p - url: %s [cachedFrameCount = %ld nextFrame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), ++m_cachedFrameCount, nextFrame);
-        else {
-            m_source->requestFrameAsyncDecodingAtIndex(nextFrame, m_currentSubsamplingLevel);
+        if (frameHasDecodedNativeImageCompatibleWithOptionsAtIndex(nextFrame, m_currentSubsamplingLevel, DecodingOptions(Optional<IntSize>()))) {
+            ++m_cachedFrameCount;
+            LOG(Images, "BitmapImage::%s - %p - url: %s [cachedFrameCount = %u nextFrame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), m_cachedFrameCount, nextFrame);
+        } else {
+            // nextFrame may already be on its way if it was requested ahead of time.
+            if (!frameIsBeingDecodedAndIsCompatibleWithOptionsAtIndex(nextFrame, DecodingOptions(DecodingMode::Asynchronous)))
+                m_source->requestFrameAsyncDecodingAtIndex(nextFrame, m_currentSubsamplingLevel);
             m_currentFrameDecodingStatus = DecodingStatus::Decoding;
             LOG(Images, "BitmapImage::%s - %p - url: %s [requesting async decoding for nextFrame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), nextFrame);
         }
 
+        requestDecodingAheadOfFrame(nextFrame);
+
         if (m_clearDecoderAfterAsyncFrameRequestForTesting)
             m_source->resetData(data());
     }
@@ -524,13 +548,49 @@ void BitmapImage::advanceAnimation()
         // Force repaint if showDebugBackground() is on.
         if (m_showDebugBackground)
             imageObserver()->changedInRect(*this);
-        LOG(Images, "BitmapImage::%s - %p - url: %s [lateFrameCount = %ld nextFrame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), ++m_lateFrameCount, nextFrame);
+        m_nextFrameIsLate = true;
+        ++m_lateFrameCount;
+        LOG(Images, "BitmapImage::%s - %p - url: %s [lateFrameCount = %u nextFrame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), m_lateFrameCount, nextFrame);
+    }
+}
+
+size_t BitmapImage::decodeAheadFrameCount(size_t nextFrame) const
+{
+    // Very large animations only hold on to one frame at a time, and frames decoded ahead
+    // would be the first to go under memory pressure anyway.
+    if (m_source->decodedSize() >= LargeAnimationCutoff || MemoryPressureHandler::singleton().isUnderMemoryPressure())
+        return 1;
+
+    // Keep enough frames in flight to hide the measured cost of decoding one frame.
+    Seconds frameDuration = frameDurationAtIndex(nextFrame);
+    Seconds decodingDuration = m_source->averageAsyncFrameDecodingDuration();
+    size_t count = MinimumDecodeAheadFrameCount;
+    if (frameDuration > 0_s && decodingDuration > 0_s)
+        count = std::max(count, static_cast<size_t>(std::ceil(decodingDuration / frameDuration)) + 1);
+    return std::min(count, MaximumDecodeAheadFrameCount);
+}
+
+void BitmapImage::requestDecodingAheadOfFrame(size_t nextFrame)
+{
+    size_t count = std::min(decodeAheadFrameCount(nextFrame), frameCount() - 1);
+    for (size_t i = 1; i < count; ++i) {
+        size_t index = (nextFrame + i) % frameCount();
+        if (!m_source->isAllDataReceived() && !frameIsCompleteAtIndex(index))
+            break;
+
+        if (frameHasDecodedNativeImageCompatibleWithOptionsAtIndex(index, m_currentSubsamplingLevel, DecodingOptions(Optional<IntSize>()))
+            || frameIsBeingDecodedAndIsCompatibleWithOptionsAtIndex(index, DecodingOptions(DecodingMode::Asynchronous)))
+            continue;
+
+        LOG(Images, "BitmapImage::%s - %p - url: %s [requesting async decoding ahead for frame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), index);
+        m_source->requestFrameAsyncDecodingAtIndex(index, m_currentSubsamplingLevel);
     }
 }
 
 void BitmapImage::internalAdvanceAnimation()
 {
     m_currentFrame = (m_currentFrame + 1) % frameCount();
+    m_nextFrameIsLate = false;
     ASSERT(!frameIsBeingDecodedAndIsCompatibleWithOptionsAtIndex(m_currentFrame, DecodingOptions(DecodingMode::Asynchronous)));
 
     destroyDecodedDataIfNecessary(false);
@@ -564,6 +624,7 @@ void BitmapImage::resetAnimation()
 {
     stopAnimation();
     m_currentFrame = 0;
+    m_nextFrameIsLate = false;
     m_repetitionsComplete = RepetitionCountNone;
     m_desiredFrameStartTime = { };
     m_animationFinished = false;
@@ -624,11 +685,20 @@ void BitmapImage::imageFrameAvailableAtIndex(size_t index)
 
     if (canAnimate()) {
         if (index == (m_currentFrame + 1) % frameCount()) {
-            // Don't advance to nextFrame unless the timer was fired before its decoding finishes.
-            if (!m_frameTimer)
+            // Don't advance to nextFrame unless the timer was fired before its decoding finishes. Otherwise the
+            // frame stays cached and the timer advances the animation once the current frame has had its duration.
+            if (m_nextFrameIsLate)
                 internalAdvanceAnimation();
-            else
-                LOG(Images, "BitmapImage::%s - %p - url: %s [earlyFrameCount = %ld nextFrame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), ++m_earlyFrameCount, index);
+            else if (m_frameTimer) {
+                ++m_earlyFrameCount;
+                LOG(Images, "BitmapImage::%s - %p - url: %s [earlyFrameCount = %u nextFrame = %ld]", __FUNCTION__, this, sourceURL().string().utf8().data(), m_earlyFrameCount, index);
+            }
+            return;
+        }
+
+        // Frames decoded ahead of the next one stay cached until their turn comes.
+        if (index != m_currentFrame) {
+            LOG(Images, "BitmapImage::%s - %p - url: %s [frame %ld was decoded ahead]", __FUNCTION__, this, sourceURL().string().utf8().data(), index);
             return;
         }
 
@@ -662,6 +732,11 @@ unsigned BitmapImage::decodeCountForTesting() const
     return m_decodeCountForTesting;
 }
 
+BitmapImage::AnimationStatistics BitmapImage::animationStatisticsForTesting() const
+{
+    return { m_source->asyncDecodedFrameCount(), m_source->averageAsyncFrameDecodingDuration(), m_cachedFrameCount, m_earlyFrameCount, m_lateFrameCount, m_skippedFrameCount };
+}
+
 void BitmapImage::dump(TextStream& ts) const
 {
     Image::dump(ts);
@@ -117,6 +117,16 @@ public:
 
     WEBCORE_EXPORT unsigned decodeCountForTesting() const;
 
+    struct AnimationStatistics {
+        unsigned decodedFrameCount;
+        Seconds averageFrameDecodingDuration;
+        unsigned cachedFrameCount;
+        unsigned earlyFrameCount;
+        unsigned lateFrameCount;
+        unsigned skippedFrameCount;
+    };
+    WEBCORE_EXPORT AnimationStatistics animationStatisticsForTesting() const;
+
     // Accessors for native image formats.
 #if USE(APPKIT)
     NSImage *nsImage() override;
@@ -207,6 +217,8 @@ private:
 
     void clearTimer();
     void startTimer(Seconds delay);
+    size_t decodeAheadFrameCount(size_t nextFrame) const;
+    void requestDecodingAheadOfFrame(size_t nextFrame);
     SubsamplingLevel subsamplingLevelForScaleFactor(GraphicsContext&, const FloatSize& scaleFactor);
     bool canDestroyDecodedData();
     void setCurrentFrameDecodingStatusIfNecessary(DecodingStatus);
@@ -217,6 +229,11 @@ private:
     // Animated images over a certain size are considered large enough that we'll only hang on to one frame at a time.
     static const unsigned LargeAnimationCutoff = 30 * 1024 * 1024;
 
+    // Bounds on the number of upcoming frames kept decoded, or being decoded, ahead of the
+    // animation. Must stay below ImageSource's frame request queue size.
+    static const size_t MinimumDecodeAheadFrameCount = 2;
+    static const size_t MaximumDecodeAheadFrameCount = 4;
+
     mutable Ref<ImageSource> m_source;
 
     size_t m_currentFrame { 0 }; // The index of the current frame of animation.
@@ -225,13 +242,14 @@ private:
     std::unique_ptr<Timer> m_frameTimer;
     RepetitionCount m_repetitionsComplete { RepetitionCountNone }; // How many repetitions we've finished.
     MonotonicTime m_desiredFrameStartTime; // The system time at which we hope to see the next call to startAnimation().
+    bool m_nextFrameIsLate { false }; // The timer for the next frame fired before its decoding finished.
 
     std::unique_ptr<Vector<Function<void()>, 1>> m_decodingCallbacks;
 
     bool m_animationFinished { false };
 
     // The default value of m_allowSubsampling should be the same as default value of the ImageSubsamplingEnabled setting.
-#if PLATFORM(IOS_FAMILY)
+#if PLATFORM(IOS_FAMILY) || PLATFORM(GTK) || PLATFORM(WPE)
     bool m_allowSubsampling { true };
 #else
     bool m_allowSubsampling { false };
@@ -242,11 +260,10 @@ private:
     bool m_clearDecoderAfterAsyncFrameRequestForTesting { false };
     bool m_largeImageAsyncDecodingEnabledForTesting { false };
 
-#if ASSERT_ENABLED || !LOG_DISABLED
-    size_t m_lateFrameCount { 0 };
-    size_t m_earlyFrameCount { 0 };
-    size_t m_cachedFrameCount { 0 };
-#endif
+    unsigned m_lateFrameCount { 0 };
+    unsigned m_earlyFrameCount { 0 };
+    unsigned m_cachedFrameCount { 0 };
+    unsigned m_skippedFrameCount { 0 };
 
     unsigned m_decodeCountForTesting { 0 };
 
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2020 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DecodedImageFrameCache.h"
+
+#include "Logging.h"
+#include <wtf/MainThread.h>
+#include <wtf/MemoryPressureHandler.h>
+
+namespace WebCore {
+
+DecodedImageFrameCache& DecodedImageFrameCache::singleton()
+{
+    ASSERT(isMainThread());
+    static NeverDestroyed<DecodedImageFrameCache> cache;
+    return cache;
+}
+
+void DecodedImageFrameCache::add(const ImageSource& source, size_t index, const IntSize& size, const PlatformImagePtr& image)
+{
+    ASSERT(image);
+    size_t capacity = this->capacity();
+    unsigned frameBytes = (size.area() * sizeof(uint32_t)).unsafeGet();
+    if (!frameBytes || frameBytes > capacity)
+        return;
+
+    Key key { &source, index, size };
+    auto& entry = m_entries.add(key, Entry { }).iterator->value;
+    if (entry.image)
+        m_size -= entry.frameBytes;
+
+    entry.image = image;
+    entry.frameBytes = frameBytes;
+    m_size += frameBytes;
+    m_lruList.appendOrMoveToLast(key);
+
+    pruneToSize(capacity);
+}
+
+PlatformImagePtr DecodedImageFrameCache::take(const ImageSource& source, size_t index, const IntSize& size)
+{
+    auto it = m_entries.find(Key { &source, index, size });
+    if (it == m_entries.end() || !it->value.image) {
+        ++m_missCount;
+        return nullptr;
+    }
+
+    ++m_hitCount;
+
+    // The frame goes back to its ImageSource which accounts for it again. The entry stays
+    // behind without an image so that its use count survives the next prune.
+    auto& entry = it->value;
+    ++entry.useCount;
+    m_size -= entry.frameBytes;
+    m_lruList.remove(it->key);
+    return std::exchange(entry.image, nullptr);
+}
+
+void DecodedImageFrameCache::remove(const ImageSource& source)
+{
+    m_entries.removeIf([&](auto& keyAndEntry) {
+        if (keyAndEntry.key.source != &source)
+            return false;
+        if (keyAndEntry.value.image)
+            removeEntry(keyAndEntry.key, keyAndEntry.value);
+        return true;
+    });
+}
+
+void DecodedImageFrameCache::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    prune();
+}
+
+size_t DecodedImageFrameCache::capacity() const
+{
+    switch (MemoryPressureHandler::currentMemoryUsagePolicy()) {
+    case WTF::MemoryUsagePolicy::Unrestricted:
+        return m_capacity;
+    case WTF::MemoryUsagePolicy::Conservative:
+        return m_capacity / 2;
+    case WTF::MemoryUsagePolicy::Strict:
+        return 0;
+    }
+
+    ASSERT_NOT_REACHED();
+    return m_capacity;
+}
+
+void DecodedImageFrameCache::prune()
+{
+    pruneToSize(capacity());
+}
+
+void DecodedImageFrameCache::clear()
+{
+    pruneToSize(0);
+}
+
+void DecodedImageFrameCache::pruneToSize(size_t targetSize)
+{
+    if (m_size <= targetSize)
+        return;
+
+    LOG(Images, "DecodedImageFrameCache::%s - pruning from %zu to %zu bytes", __FUNCTION__, m_size, targetSize);
+
+    while (m_size > targetSize) {
+        ASSERT(!m_lruList.isEmpty());
+        auto key = m_lruList.first();
+        auto it = m_entries.find(key);
+        ASSERT(it != m_entries.end());
+
+        // Give frames which were reused before another trip through the list, unless
+        // everything has to go. Each pass consumes one use, so this always terminates.
+        if (targetSize && it->value.useCount) {
+            --it->value.useCount;
+            m_lruList.appendOrMoveToLast(key);
+            continue;
+        }
+
+        removeEntry(key, it->value);
+        m_entries.remove(it);
+        ++m_evictionCount;
+    }
+}
+
+void DecodedImageFrameCache::removeEntry(const Key& key, Entry& entry)
+{
+    ASSERT(entry.image);
+    m_size -= entry.frameBytes;
+    entry.image = nullptr;
+    m_lruList.remove(key);
+}
+
+auto DecodedImageFrameCache::statistics() const -> Statistics
+{
+    return { m_hitCount, m_missCount, m_evictionCount, m_size, capacity() };
+}
+
+void DecodedImageFrameCache::resetStatistics()
+{
+    m_hitCount = 0;
+    m_missCount = 0;
+    m_evictionCount = 0;
+}
+
+} // namespace WebCore
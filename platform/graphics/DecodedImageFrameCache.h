@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2020 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "IntSize.h"
+#include "IntSizeHash.h"
+#include "PlatformImage.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/NeverDestroyed.h>
+
+namespace WebCore {
+
+class ImageSource;
+
+// Holds on to complete frames that ImageSource has thrown away when its decoded data
+// was pruned, so that an image which is painted again soon after (e.g. a thumbnail
+// scrolled back into view) does not have to be decoded from scratch. The cache has a
+// byte budget which shrinks as the process memory usage policy gets stricter.
+class DecodedImageFrameCache {
+    WTF_MAKE_NONCOPYABLE(DecodedImageFrameCache); WTF_MAKE_FAST_ALLOCATED;
+    friend NeverDestroyed<DecodedImageFrameCache>;
+public:
+    struct Statistics {
+        unsigned hitCount { 0 };
+        unsigned missCount { 0 };
+        unsigned evictionCount { 0 };
+        size_t size { 0 };
+        size_t capacity { 0 };
+    };
+
+    WEBCORE_EXPORT static DecodedImageFrameCache& singleton();
+
+    void add(const ImageSource&, size_t index, const IntSize&, const PlatformImagePtr&);
+    PlatformImagePtr take(const ImageSource&, size_t index, const IntSize&);
+    void remove(const ImageSource&);
+
+    WEBCORE_EXPORT void setCapacity(size_t);
+    size_t capacity() const;
+    size_t size() const { return m_size; }
+
+    // Evicts down to the capacity allowed by the current memory usage policy.
+    void prune();
+    WEBCORE_EXPORT void clear();
+
+    WEBCORE_EXPORT Statistics statistics() const;
+    WEBCORE_EXPORT void resetStatistics();
+
+private:
+    DecodedImageFrameCache() = default;
+
+    struct Key {
+        const ImageSource* source { nullptr };
+        size_t index { 0 };
+        IntSize size;
+
+        bool operator==(const Key& other) const { return source == other.source && index == other.index && size == other.size; }
+    };
+
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return pairIntHash(PtrHash<const ImageSource*>::hash(key.source), pairIntHash(IntHash<size_t>::hash(key.index), DefaultHash<IntSize>::hash(key.size))); }
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = true;
+    };
+
+    struct KeyTraits : GenericHashTraits<Key> {
+        static const bool emptyValueIsZero = true;
+        static void constructDeletedValue(Key& slot) { slot.source = reinterpret_cast<const ImageSource*>(-1); }
+        static bool isDeletedValue(const Key& key) { return key.source == reinterpret_cast<const ImageSource*>(-1); }
+    };
+
+    struct Entry {
+        PlatformImagePtr image;
+        unsigned frameBytes { 0 };
+        // Number of times this frame was brought back after a prune. Frequently reused
+        // frames get a second chance before they are evicted.
+        unsigned useCount { 0 };
+    };
+
+    void pruneToSize(size_t);
+    void removeEntry(const Key&, Entry&);
+
+    HashMap<Key, Entry, KeyHash, KeyTraits> m_entries;
+    // Keys of the entries currently holding an image, least recently added first.
+    ListHashSet<Key, KeyHash> m_lruList;
+
+    size_t m_capacity { 8 * 1024 * 1024 };
+    size_t m_size { 0 };
+
+    unsigned m_hitCount { 0 };
+    unsigned m_missCount { 0 };
+    unsigned m_evictionCount { 0 };
+};
+
+} // namespace WebCore
@@ -48,9 +48,14 @@
 #include "OpenTypeVerticalData.h"
 #endif
 
+#if USE(HARFBUZZ)
+#include "ComplexTextRunCache.h"
+#include <wtf/MainThread.h>
+#endif
+
 namespace WebCore {
 
-unsigned GlyphPage::s_count = 0;
+std::atomic<unsigned> GlyphPage::s_count { 0 };
 
 const float smallCapsFontSizeMultiplier = 0.7f;
 const float emphasisMarkFontSizeMultiplier = 0.5f;
@@ -157,6 +162,11 @@ void Font::platformGlyphInit()
 Font::~Font()
 {
     removeFromSystemFallbackCache();
+
+#if USE(HARFBUZZ)
+    if (isMainThread())
+        ComplexTextRunCache::singleton().remove(*this);
+#endif
 }
 
 RenderingResourceIdentifier Font::renderingResourceIdentifier() const
@@ -385,16 +395,32 @@ static RefPtr<GlyphPage> createAndFillGlyphPage(unsigned pageNumber, const Font&
 
 const GlyphPage* Font::glyphPage(unsigned pageNumber) const
 {
+    // Pages are never removed once published, so the returned pointers stay valid for the lifetime of the Font.
+    // They are built outside of the lock; when two threads race to build the same page, the first one to publish wins.
     if (!pageNumber) {
-        if (!m_glyphPageZero)
-            m_glyphPageZero = createAndFillGlyphPage(0, *this);
+        // Page zero is looked up for almost every character, so reading it does not take the lock.
+        if (m_hasGlyphPageZero.load(std::memory_order_acquire))
+            return m_glyphPageZero.get();
+
+        auto page = createAndFillGlyphPage(0, *this);
+        auto locker = holdLock(m_glyphPagesLock);
+        if (!m_hasGlyphPageZero.load(std::memory_order_relaxed)) {
+            m_glyphPageZero = WTFMove(page);
+            m_hasGlyphPageZero.store(true, std::memory_order_release);
+        }
         return m_glyphPageZero.get();
     }
-    auto addResult = m_glyphPages.add(pageNumber, nullptr);
-    if (addResult.isNewEntry)
-        addResult.iterator->value = createAndFillGlyphPage(pageNumber, *this);
 
-    return addResult.iterator->value.get();
+    {
+        auto locker = holdLock(m_glyphPagesLock);
+        auto iterator = m_glyphPages.find(pageNumber);
+        if (iterator != m_glyphPages.end())
+            return iterator->value.get();
+    }
+
+    auto page = createAndFillGlyphPage(pageNumber, *this);
+    auto locker = holdLock(m_glyphPagesLock);
+    return m_glyphPages.add(pageNumber, WTFMove(page)).iterator->value.get();
 }
 
 Glyph Font::glyphForCharacter(UChar32 character) const
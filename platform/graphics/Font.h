@@ -35,8 +35,10 @@
 #include "OpenTypeVerticalData.h"
 #endif
 #include "RenderingResourceIdentifier.h"
+#include <atomic>
 #include <wtf/BitVector.h>
 #include <wtf/Hasher.h>
+#include <wtf/Lock.h>
 #include <wtf/Optional.h>
 #include <wtf/text/StringHash.h>
 
@@ -259,6 +261,8 @@ private:
 
     const FontPlatformData m_platformData;
 
+    mutable Lock m_glyphPagesLock;
+    mutable std::atomic<bool> m_hasGlyphPageZero { false };
     mutable RefPtr<GlyphPage> m_glyphPageZero;
     mutable HashMap<unsigned, RefPtr<GlyphPage>> m_glyphPages;
     mutable std::unique_ptr<GlyphMetricsMap<FloatRect>> m_glyphToBoundsMap;
@@ -488,7 +488,7 @@ static RefPtr<GlyphPage> glyphPageFromFontRanges(unsigned pageNumber, const Font
 
 GlyphData FontCascadeFonts::glyphDataForCharacter(UChar32 c, const FontCascadeDescription& description, FontVariant variant)
 {
-    ASSERT(isMainThread());
+    ASSERT(m_creationThread.ptr() == &Thread::current());
     ASSERT(variant != AutoVariant);
 
     if (variant != NormalVariant)
@@ -28,6 +28,7 @@
 #include "WidthCache.h"
 #include <wtf/Forward.h>
 #include <wtf/MainThread.h>
+#include <wtf/Threading.h>
 
 #if PLATFORM(IOS_FAMILY)
 #include "WebCoreThread.h"
@@ -114,6 +115,10 @@ private:
     unsigned short m_generation;
     Pitch m_pitch { UnknownPitch };
     bool m_isForPlatformFont { false };
+#if ASSERT_ENABLED
+    // The glyph page cache and the width cache are not shared; each FontCascadeFonts is used only by the thread that created it.
+    Ref<Thread> m_creationThread { Thread::current() };
+#endif
 };
 
 inline bool FontCascadeFonts::isFixedPitch(const FontCascadeDescription& description)
@@ -125,7 +130,7 @@ inline bool FontCascadeFonts::isFixedPitch(const FontCascadeDescription& descrip
 
 inline const Font& FontCascadeFonts::primaryFont(const FontCascadeDescription& description)
 {
-    ASSERT(isMainThread());
+    ASSERT(m_creationThread.ptr() == &Thread::current());
     if (!m_cachedPrimaryFont) {
         auto& primaryRanges = realizeFallbackRangesAt(description, 0);
         m_cachedPrimaryFont = primaryRanges.glyphDataForCharacter(' ', ExternalResourceDownloadPolicy::Allow).font;
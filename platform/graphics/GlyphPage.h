@@ -31,9 +31,10 @@
 #define GlyphPage_h
 
 #include "Glyph.h"
+#include <atomic>
 #include <unicode/utypes.h>
-#include <wtf/RefCounted.h>
 #include <wtf/Ref.h>
+#include <wtf/ThreadSafeRefCounted.h>
 
 namespace WebCore {
 
@@ -57,7 +58,9 @@ struct GlyphData {
 // A GlyphPage contains a fixed-size set of GlyphData mappings for a contiguous
 // range of characters in the Unicode code space. GlyphPages are indexed
 // starting from 0 and incrementing for each "size" number of glyphs.
-class GlyphPage : public RefCounted<GlyphPage> {
+// Pages are immutable once filled, so they can be read from any thread.
+class GlyphPage : public ThreadSafeRefCounted<GlyphPage> {
+    friend class OpenTypeVerticalData;
 public:
     static Ref<GlyphPage> create(const Font& font)
     {
@@ -101,13 +104,6 @@ public:
         return m_glyphs[index];
     }
 
-    // FIXME: Pages are immutable after initialization. This should be private.
-    void setGlyphForIndex(unsigned index, Glyph glyph)
-    {
-        ASSERT_WITH_SECURITY_IMPLICATION(index < size);
-        m_glyphs[index] = glyph;
-    }
-
     const Font& font() const
     {
         return m_font;
@@ -117,6 +113,13 @@ public:
     bool fill(UChar* characterBuffer, unsigned bufferLength);
 
 private:
+    // Only used while the page is filled, before it is published.
+    void setGlyphForIndex(unsigned index, Glyph glyph)
+    {
+        ASSERT_WITH_SECURITY_IMPLICATION(index < size);
+        m_glyphs[index] = glyph;
+    }
+
     explicit GlyphPage(const Font& font)
         : m_font(font)
     {
@@ -126,7 +129,7 @@ private:
     const Font& m_font;
     Glyph m_glyphs[size] { };
 
-    WEBCORE_EXPORT static unsigned s_count;
+    WEBCORE_EXPORT static std::atomic<unsigned> s_count;
 };
 
 } // namespace WebCore
@@ -27,6 +27,7 @@
 #include "ImageSource.h"
 
 #include "BitmapImage.h"
+#include "DecodedImageFrameCache.h"
 #include "ImageDecoder.h"
 #include "ImageObserver.h"
 #include "Logging.h"
@@ -68,6 +69,9 @@ ImageSource::~ImageSource()
 {
     ASSERT(!hasAsyncDecodingQueue());
     ASSERT(&m_runLoop == &RunLoop::current());
+
+    if (m_hasFramesInDecodedImageFrameCache)
+        DecodedImageFrameCache::singleton().remove(*this);
 }
 
 bool ImageSource::ensureDecoderAvailable(SharedBuffer* data)
@@ -132,12 +136,35 @@ void ImageSource::destroyDecodedData(size_t frameCount, size_t excludeFrame)
     for (size_t index = 0; index < frameCount; ++index) {
         if (index == excludeFrame)
             continue;
+        cacheFrameBeforeDestroyingDecodedData(index);
         decodedSize += m_frames[index].clearImage();
     }
 
     decodedSizeReset(decodedSize);
 }
 
+void ImageSource::cacheFrameBeforeDestroyingDecodedData(size_t index)
+{
+    // Animated images keep cycling through their frames, so only still images are worth
+    // holding on to. Frames decoded for a specific drawing size are not reusable.
+    if (!isMainThread() || !isDecoderAvailable() || m_frames.size() != 1 || !isAllDataReceived())
+        return;
+
+    auto& frame = m_frames[index];
+    if (!frame.isComplete() || !frame.hasNativeImage() || frame.m_decodingOptions.hasSizeForDrawing())
+        return;
+
+    DecodedImageFrameCache::singleton().add(*this, index, frame.nativeImage()->size(), frame.nativeImage()->platformImage());
+    m_hasFramesInDecodedImageFrameCache = true;
+}
+
+PlatformImagePtr ImageSource::takeFrameFromDecodedImageFrameCache(size_t index, SubsamplingLevel subsamplingLevel)
+{
+    if (!m_hasFramesInDecodedImageFrameCache)
+        return nullptr;
+    return DecodedImageFrameCache::singleton().take(*this, index, m_decoder->frameSizeAtIndex(index, subsamplingLevel));
+}
+
 void ImageSource::destroyIncompleteDecodedData()
 {
     unsigned decodedSize = 0;
@@ -358,9 +385,7 @@ void ImageSource::startAsyncDecodingQueue()
         while (protectedFrameRequestQueue->dequeue(frameRequest)) {
             TraceScope tracingScope(AsyncImageDecodeStart, AsyncImageDecodeEnd);
 
-            MonotonicTime startingTime;
-            if (minDecodingDuration > 0_s)
-                startingTime = MonotonicTime::now();
+            MonotonicTime startingTime = MonotonicTime::now();
 
             // Get the frame NativeImage on the decoding thread.
             auto platformImage = protectedDecoder->createFrameImageAtIndex(frameRequest.index, frameRequest.subsamplingLevel, frameRequest.decodingOptions);
@@ -371,16 +396,20 @@ void ImageSource::startAsyncDecodingQueue()
                 continue;
             }
 
+            Seconds decodingDuration = MonotonicTime::now() - startingTime;
+
             // Pretend as if the decoding takes minDecodingDuration.
             if (minDecodingDuration > 0_s)
                 sleep(minDecodingDuration - (MonotonicTime::now() - startingTime));
 
             // Update the cached frames on the creation thread to avoid updating the MemoryCache from a different thread.
-            callOnMainThread([protectedThis, protectedDecodingQueue, protectedDecoder, sourceURL = sourceURL.isolatedCopy(), platformImage = WTFMove(platformImage), frameRequest] () mutable {
+            callOnMainThread([protectedThis, protectedDecodingQueue, protectedDecoder, sourceURL = sourceURL.isolatedCopy(), platformImage = WTFMove(platformImage), frameRequest, decodingDuration] () mutable {
                 // The queue may have been closed if after we got the frame NativeImage, stopAsyncDecodingQueue() was called.
                 if (protectedDecodingQueue.ptr() == protectedThis->m_decodingQueue && protectedDecoder.ptr() == protectedThis->m_decoder) {
                     ASSERT(protectedThis->m_frameCommitQueue.first() == frameRequest);
                     protectedThis->m_frameCommitQueue.removeFirst();
+                    ++protectedThis->m_asyncDecodedFrameCount;
+                    protectedThis->m_totalAsyncFrameDecodingDuration += decodingDuration;
                     protectedThis->cachePlatformImageAtIndexAsync(WTFMove(platformImage), frameRequest.index, frameRequest.subsamplingLevel, frameRequest.decodingOptions, frameRequest.decodingStatus);
                 } else
                     LOG(Images, "ImageSource::%s - %p - url: %s [frame %ld will not cached]", __FUNCTION__, protectedThis.ptr(), sourceURL.utf8().data(), frameRequest.index);
@@ -454,10 +483,16 @@ const ImageFrame& ImageSource::frameAtIndexCacheIfNeeded(size_t index, ImageFram
         // Cache the image and retrieve the metadata from ImageDecoder only if there was not valid image stored.
         if (frame.hasFullSizeNativeImage(subsamplingLevel))
             break;
-        // We have to perform synchronous image decoding in this code.
-        auto platformImage = m_decoder->createFrameImageAtIndex(index, subsamplingLevelValue);
+        // We have to perform synchronous image decoding in this code, unless the frame
+        // was kept around when the decoded data was last destroyed.
+        // Only complete frames are kept in the DecodedImageFrameCache. The decoder was reset when the frame was
+        // dropped, so it cannot tell that the frame is complete until it decodes it again.
+        if (auto platformImage = takeFrameFromDecodedImageFrameCache(index, subsamplingLevelValue)) {
+            cachePlatformImageAtIndex(WTFMove(platformImage), index, subsamplingLevelValue, DecodingOptions(DecodingMode::Synchronous), DecodingStatus::Complete);
+            break;
+        }
         // Clean the old native image and set a new one.
-        cachePlatformImageAtIndex(WTFMove(platformImage), index, subsamplingLevelValue, DecodingOptions(DecodingMode::Synchronous));
+        cachePlatformImageAtIndex(m_decoder->createFrameImageAtIndex(index, subsamplingLevelValue), index, subsamplingLevelValue, DecodingOptions(DecodingMode::Synchronous));
         break;
     }
 
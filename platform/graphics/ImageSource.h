@@ -86,6 +86,10 @@ public:
     void setFrameDecodingDurationForTesting(Seconds duration) { m_frameDecodingDurationForTesting = duration; }
     Seconds frameDecodingDurationForTesting() const { return m_frameDecodingDurationForTesting; }
 
+    // Cost of the frames decoded so far on the decoding queue.
+    unsigned asyncDecodedFrameCount() const { return m_asyncDecodedFrameCount; }
+    Seconds averageAsyncFrameDecodingDuration() const { return m_asyncDecodedFrameCount ? m_totalAsyncFrameDecodingDuration / m_asyncDecodedFrameCount : 0_s; }
+
     // Image metadata which is calculated either by the ImageDecoder or directly
     // from the NativeImage if this class was created for a memory image.
     EncodedDataStatus encodedDataStatus();
@@ -145,6 +149,8 @@ private:
     bool ensureDecoderAvailable(SharedBuffer* data);
     bool isDecoderAvailable() const { return m_decoder; }
     void destroyDecodedData(size_t frameCount, size_t excludeFrame);
+    void cacheFrameBeforeDestroyingDecodedData(size_t);
+    PlatformImagePtr takeFrameFromDecodedImageFrameCache(size_t, SubsamplingLevel);
     void decodedSizeChanged(long long decodedSize);
     void didDecodeProperties(unsigned decodedPropertiesSize);
     void decodedSizeIncreased(unsigned decodedSize);
@@ -174,6 +180,7 @@ private:
     unsigned m_decodedSize { 0 };
     unsigned m_decodedPropertiesSize { 0 };
     Vector<ImageFrame, 1> m_frames;
+    bool m_hasFramesInDecodedImageFrameCache { false };
 
     // Asynchronous image decoding.
     struct ImageFrameRequest {
@@ -192,6 +199,8 @@ private:
     FrameCommitQueue m_frameCommitQueue;
     RefPtr<WorkQueue> m_decodingQueue;
     Seconds m_frameDecodingDurationForTesting;
+    unsigned m_asyncDecodedFrameCount { 0 };
+    Seconds m_totalAsyncFrameDecodingDuration;
 
     // Image metadata.
     Optional<EncodedDataStatus> m_encodedDataStatus;
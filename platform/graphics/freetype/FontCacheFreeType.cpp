@@ -30,6 +30,7 @@
 #include "Font.h"
 #include "FontDescription.h"
 #include "FontCacheFreeType.h"
+#include "PersistentFontFallbackCache.h"
 #include "RefPtrCairo.h"
 #include "RefPtrFontconfig.h"
 #include "UTF16UChar32Iterator.h"
@@ -132,20 +133,28 @@ class CachedFontSet {
 public:
     explicit CachedFontSet(RefPtr<FcPattern>&& pattern)
         : m_pattern(WTFMove(pattern))
+        , m_patternHash(FcPatternHash(m_pattern.get()))
     {
-        FcResult result;
-        m_fontSet.reset(FcFontSort(nullptr, m_pattern.get(), FcTrue, nullptr, &result));
-        for (int i = 0; i < m_fontSet->nfont; ++i) {
-            FcPattern* pattern = m_fontSet->fonts[i];
-            FcCharSet* charSet;
-
-            if (FcPatternGetCharSet(pattern, FC_CHARSET, 0, &charSet) == FcResultMatch)
-                m_patterns.append({ pattern, charSet });
-        }
     }
 
+    FcPattern* pattern() const { return m_pattern.get(); }
+    unsigned patternHash() const { return m_patternHash; }
+
     RefPtr<FcPattern> bestForCharacters(const UChar* characters, unsigned length)
     {
+        // Sorting is by far the most expensive part, so it is only done once the persistent cache missed.
+        if (!m_fontSet) {
+            FcResult result;
+            m_fontSet.reset(FcFontSort(nullptr, m_pattern.get(), FcTrue, nullptr, &result));
+            for (int i = 0; m_fontSet && i < m_fontSet->nfont; ++i) {
+                FcPattern* pattern = m_fontSet->fonts[i];
+                FcCharSet* charSet;
+
+                if (FcPatternGetCharSet(pattern, FC_CHARSET, 0, &charSet) == FcResultMatch)
+                    m_patterns.append({ pattern, charSet });
+            }
+        }
+
         if (m_patterns.isEmpty()) {
             FcResult result;
             return adoptRef(FcFontMatch(nullptr, m_pattern.get(), &result));
@@ -190,6 +199,7 @@ public:
 
 private:
     RefPtr<FcPattern> m_pattern;
+    unsigned m_patternHash;
     FcUniquePtr<FcFontSet> m_fontSet;
     Vector<CachedPattern> m_patterns;
 };
@@ -264,9 +274,15 @@ RefPtr<Font> FontCache::systemFallbackForCharacters(const FontDescription& descr
     if (!addResult.iterator->value)
         return nullptr;
 
-    RefPtr<FcPattern> resultPattern = addResult.iterator->value->bestForCharacters(characters, length);
-    if (!resultPattern)
-        return nullptr;
+    auto& fontSet = *addResult.iterator->value;
+    auto& persistentCache = PersistentFontFallbackCache::singleton();
+    RefPtr<FcPattern> resultPattern = persistentCache.fontForCharacters(fontSet.pattern(), fontSet.patternHash(), characters, length);
+    if (!resultPattern) {
+        resultPattern = fontSet.bestForCharacters(characters, length);
+        if (!resultPattern)
+            return nullptr;
+        persistentCache.add(fontSet.patternHash(), characters, length, resultPattern.get());
+    }
 
     bool fixedWidth, syntheticBold, syntheticOblique;
     getFontPropertiesFromPattern(resultPattern.get(), description, fixedWidth, syntheticBold, syntheticOblique);
@@ -279,6 +295,7 @@ RefPtr<Font> FontCache::systemFallbackForCharacters(const FontDescription& descr
 void FontCache::platformPurgeInactiveFontData()
 {
     systemFallbackCache().clear();
+    PersistentFontFallbackCache::singleton().clearFontSet();
 }
 
 static Vector<String> patternToFamilies(FcPattern& pattern)
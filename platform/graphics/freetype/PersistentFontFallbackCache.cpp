@@ -0,0 +1,387 @@
+/*
+ * Copyright (C) 2020 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "PersistentFontFallbackCache.h"
+
+#include "CharacterProperties.h"
+#include "RefPtrFontconfig.h"
+#include "UTF16UChar32Iterator.h"
+#include <fontconfig/fontconfig.h>
+#include <wtf/HashFunctions.h>
+#include <wtf/ProcessID.h>
+#include <wtf/text/StringConcatenateNumbers.h>
+#include <wtf/text/StringHash.h>
+
+#if USE(GLIB)
+#include <glib.h>
+#endif
+
+namespace WebCore {
+
+static constexpr uint32_t fileMagic = 0x46574b46; // "FKWF"
+static constexpr uint32_t fileVersion = 3;
+static constexpr unsigned maximumEntryCount = 16384;
+static constexpr Seconds saveDelay { 5_s };
+
+struct PersistentFontFallbackCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fontconfigVersion;
+    uint32_t fontSetFingerprint;
+    uint32_t entryCount;
+    uint32_t charactersSize;
+    uint32_t pathsSize;
+    uint32_t reserved;
+};
+
+// Entries are sorted by key. The characters of all the entries follow them, then the null-terminated paths.
+// Entries sharing a key are told apart by their characters.
+struct PersistentFontFallbackCacheEntry {
+    uint64_t key;
+    uint32_t charactersOffset;
+    uint32_t charactersLength;
+    uint32_t pathOffset;
+    int32_t index;
+};
+
+// The entries directly follow the header in the memory mapped file.
+static_assert(sizeof(PersistentFontFallbackCacheHeader) % alignof(PersistentFontFallbackCacheEntry) == 0, "PersistentFontFallbackCacheEntry must be aligned in the file");
+
+static const PersistentFontFallbackCacheEntry* fileEntries(const PersistentFontFallbackCacheHeader& header)
+{
+    return reinterpret_cast<const PersistentFontFallbackCacheEntry*>(&header + 1);
+}
+
+static const UChar* fileCharacters(const PersistentFontFallbackCacheHeader& header)
+{
+    return reinterpret_cast<const UChar*>(fileEntries(header) + header.entryCount);
+}
+
+static const char* filePaths(const PersistentFontFallbackCacheHeader& header)
+{
+    return reinterpret_cast<const char*>(fileCharacters(header) + header.charactersSize);
+}
+
+static bool fileEntryCharactersAreValid(const PersistentFontFallbackCacheHeader& header, const PersistentFontFallbackCacheEntry& entry)
+{
+    return entry.charactersOffset <= header.charactersSize && header.charactersSize - entry.charactersOffset >= entry.charactersLength;
+}
+
+static String defaultDirectory()
+{
+#if USE(GLIB)
+    return FileSystem::pathByAppendingComponent(FileSystem::pathByAppendingComponent(FileSystem::stringFromFileSystemRepresentation(g_get_user_cache_dir()), "WebKit"), "FontFallback");
+#else
+    return { };
+#endif
+}
+
+static String cacheFilePath(const String& directory)
+{
+    return FileSystem::pathByAppendingComponent(directory, "fallback.dat");
+}
+
+PersistentFontFallbackCache& PersistentFontFallbackCache::singleton()
+{
+    static NeverDestroyed<PersistentFontFallbackCache> cache;
+    return cache;
+}
+
+PersistentFontFallbackCache::PersistentFontFallbackCache()
+    : m_directory(defaultDirectory())
+    , m_saveTimer(*this, &PersistentFontFallbackCache::save)
+{
+}
+
+void PersistentFontFallbackCache::setDirectory(const String& directory)
+{
+    auto& cache = singleton();
+    if (cache.m_directory == directory)
+        return;
+
+    cache.m_saveTimer.stop();
+    cache.m_directory = directory;
+    cache.m_isLoaded = false;
+    cache.m_file = { };
+    cache.m_addedEntries.clear();
+}
+
+uint64_t PersistentFontFallbackCache::entryKey(unsigned requestPatternHash, const UChar* characters, unsigned length)
+{
+    return (static_cast<uint64_t>(requestPatternHash) << 32) | StringHasher::computeHash(characters, length);
+}
+
+void PersistentFontFallbackCache::ensureFontSet()
+{
+    if (m_isFontSetScanned)
+        return;
+    m_isFontSetScanned = true;
+
+    m_fontSet.clear();
+    m_fontSetFingerprint = 0;
+    FcFontSet* fontSet = FcConfigGetFonts(nullptr, FcSetSystem);
+    if (!fontSet)
+        return;
+
+    m_fontSetFingerprint = fontSet->nfont;
+    for (int i = 0; i < fontSet->nfont; ++i) {
+        FcPattern* pattern = fontSet->fonts[i];
+        FcChar8* file;
+        int index;
+        if (FcPatternGetString(pattern, FC_FILE, 0, &file) != FcResultMatch || FcPatternGetInteger(pattern, FC_INDEX, 0, &index) != FcResultMatch)
+            continue;
+
+        String path = String::fromUTF8(reinterpret_cast<const char*>(file));
+        m_fontSetFingerprint = WTF::pairIntHash(m_fontSetFingerprint, WTF::pairIntHash(path.hash(), index));
+        m_fontSet.add(std::make_pair(WTFMove(path), index), pattern);
+    }
+}
+
+void PersistentFontFallbackCache::ensureLoaded()
+{
+    if (m_isLoaded)
+        return;
+    m_isLoaded = true;
+
+    if (m_directory.isEmpty())
+        return;
+
+    ensureFontSet();
+
+    bool success = false;
+    FileSystem::MappedFileData file(cacheFilePath(m_directory), FileSystem::MappedFileMode::Private, success);
+    if (!success || file.size() < sizeof(PersistentFontFallbackCacheHeader))
+        return;
+
+    auto& header = *static_cast<const PersistentFontFallbackCacheHeader*>(file.data());
+    if (header.magic != fileMagic || header.version != fileVersion || header.fontconfigVersion != static_cast<uint32_t>(FcGetVersion()) || header.fontSetFingerprint != m_fontSetFingerprint)
+        return;
+
+    size_t expectedSize = sizeof(PersistentFontFallbackCacheHeader) + header.entryCount * sizeof(PersistentFontFallbackCacheEntry) + header.charactersSize * sizeof(UChar) + header.pathsSize;
+    if (header.entryCount > maximumEntryCount || file.size() != expectedSize)
+        return;
+
+    m_file = WTFMove(file);
+}
+
+auto PersistentFontFallbackCache::lookup(unsigned requestPatternHash, const UChar* characters, unsigned length) const -> Optional<FontFile>
+{
+    auto iterator = m_addedEntries.find(std::make_pair(String(characters, length), requestPatternHash));
+    if (iterator != m_addedEntries.end())
+        return iterator->value;
+
+    if (!m_file.size())
+        return WTF::nullopt;
+
+    auto& header = *static_cast<const PersistentFontFallbackCacheHeader*>(m_file.data());
+    auto* entries = fileEntries(header);
+    auto* end = entries + header.entryCount;
+    auto key = entryKey(requestPatternHash, characters, length);
+    auto* entry = std::lower_bound(entries, end, key, [](auto& entry, uint64_t key) {
+        return entry.key < key;
+    });
+    for (; entry != end && entry->key == key; ++entry) {
+        if (entry->charactersLength != length || !fileEntryCharactersAreValid(header, *entry))
+            continue;
+        if (std::equal(characters, characters + length, fileCharacters(header) + entry->charactersOffset))
+            return fontFileForFileEntry(*entry);
+    }
+    return WTF::nullopt;
+}
+
+auto PersistentFontFallbackCache::fontFileForFileEntry(const PersistentFontFallbackCacheEntry& entry) const -> Optional<FontFile>
+{
+    auto& header = *static_cast<const PersistentFontFallbackCacheHeader*>(m_file.data());
+    if (entry.pathOffset >= header.pathsSize)
+        return WTF::nullopt;
+
+    auto* path = filePaths(header) + entry.pathOffset;
+    auto pathLength = strnlen(path, header.pathsSize - entry.pathOffset);
+    if (entry.pathOffset + pathLength == header.pathsSize)
+        return WTF::nullopt;
+    return FontFile { CString(path, pathLength), entry.index };
+}
+
+FcPattern* PersistentFontFallbackCache::fontPatternForFile(const FontFile& fontFile)
+{
+    ensureFontSet();
+    return m_fontSet.get(std::make_pair(String::fromUTF8(fontFile.path.data()), fontFile.index));
+}
+
+static bool fontCoversCharacters(FcPattern* pattern, const UChar* characters, unsigned length)
+{
+    FcCharSet* charSet;
+    if (FcPatternGetCharSet(pattern, FC_CHARSET, 0, &charSet) != FcResultMatch)
+        return false;
+
+    UTF16UChar32Iterator iterator(characters, length);
+    for (UChar32 character = iterator.next(); character != iterator.end(); character = iterator.next()) {
+        if (!isDefaultIgnorableCodePoint(character) && !FcCharSetHasChar(charSet, character))
+            return false;
+    }
+    return true;
+}
+
+RefPtr<FcPattern> PersistentFontFallbackCache::fontForCharacters(FcPattern* requestPattern, unsigned requestPatternHash, const UChar* characters, unsigned length)
+{
+    ensureLoaded();
+
+    auto fontFile = lookup(requestPatternHash, characters, length);
+    if (!fontFile)
+        return nullptr;
+
+    // Fonts updated in place are caught by checking the coverage again.
+    auto* fontPattern = fontPatternForFile(*fontFile);
+    if (!fontPattern || !fontCoversCharacters(fontPattern, characters, length))
+        return nullptr;
+
+    return adoptRef(FcFontRenderPrepare(nullptr, requestPattern, fontPattern));
+}
+
+void PersistentFontFallbackCache::add(unsigned requestPatternHash, const UChar* characters, unsigned length, FcPattern* resultPattern)
+{
+    ensureLoaded();
+    if (m_directory.isEmpty() || m_addedEntries.size() >= maximumEntryCount)
+        return;
+
+    FcChar8* file;
+    int index;
+    if (FcPatternGetString(resultPattern, FC_FILE, 0, &file) != FcResultMatch || FcPatternGetInteger(resultPattern, FC_INDEX, 0, &index) != FcResultMatch)
+        return;
+
+    // Only remember fonts that fully cover the characters, the others are the best of bad choices
+    // and would be rejected when read back anyway.
+    FontFile fontFile { reinterpret_cast<const char*>(file), index };
+    auto* fontPattern = fontPatternForFile(fontFile);
+    if (!fontPattern || !fontCoversCharacters(fontPattern, characters, length))
+        return;
+
+    m_addedEntries.set(std::make_pair(String(characters, length), requestPatternHash), WTFMove(fontFile));
+    if (!m_saveTimer.isActive())
+        m_saveTimer.startOneShot(saveDelay);
+}
+
+void PersistentFontFallbackCache::clearFontSet()
+{
+    m_isFontSetScanned = false;
+    m_fontSet.clear();
+}
+
+template<typename T>
+static bool writeAllToFile(FileSystem::PlatformFileHandle file, const T* data, size_t size)
+{
+    auto* bytes = reinterpret_cast<const char*>(data);
+    size_t bytesLength = size * sizeof(T);
+    while (bytesLength) {
+        auto written = FileSystem::writeToFile(file, bytes, bytesLength);
+        if (written <= 0)
+            return false;
+        bytes += written;
+        bytesLength -= written;
+    }
+    return true;
+}
+
+void PersistentFontFallbackCache::save()
+{
+    if (m_directory.isEmpty() || m_addedEntries.isEmpty())
+        return;
+
+    // Merge the new answers with the ones already on disk; other processes may have
+    // written the file in the meantime, in which case the last writer wins.
+    HashMap<std::pair<String, unsigned>, FontFile> entries;
+    if (m_file.size()) {
+        auto& header = *static_cast<const PersistentFontFallbackCacheHeader*>(m_file.data());
+        auto* entry = fileEntries(header);
+        for (unsigned i = 0; i < header.entryCount && entries.size() < maximumEntryCount; ++i, ++entry) {
+            if (!fileEntryCharactersAreValid(header, *entry))
+                continue;
+            if (auto fontFile = fontFileForFileEntry(*entry))
+                entries.add(std::make_pair(String(fileCharacters(header) + entry->charactersOffset, entry->charactersLength), static_cast<unsigned>(entry->key >> 32)), WTFMove(*fontFile));
+        }
+    }
+    for (auto& entry : m_addedEntries) {
+        if (entries.size() >= maximumEntryCount)
+            break;
+        entries.set(entry.key, entry.value);
+    }
+
+    Vector<PersistentFontFallbackCacheEntry> sortedEntries;
+    sortedEntries.reserveInitialCapacity(entries.size());
+    Vector<UChar> characters;
+    Vector<char> paths;
+    HashMap<String, uint32_t> pathOffsets;
+    for (auto& entry : entries) {
+        auto& entryCharacters = entry.key.first;
+        uint32_t charactersOffset = characters.size();
+        for (unsigned i = 0; i < entryCharacters.length(); ++i)
+            characters.append(entryCharacters[i]);
+
+        auto pathOffset = pathOffsets.ensure(String::fromUTF8(entry.value.path.data()), [&] {
+            uint32_t offset = paths.size();
+            paths.append(entry.value.path.data(), entry.value.path.length() + 1);
+            return offset;
+        }).iterator->value;
+        uint64_t key = entryKey(entry.key.second, characters.data() + charactersOffset, entryCharacters.length());
+        sortedEntries.uncheckedAppend({ key, charactersOffset, entryCharacters.length(), pathOffset, entry.value.index });
+    }
+    std::sort(sortedEntries.begin(), sortedEntries.end(), [](auto& a, auto& b) {
+        return a.key < b.key;
+    });
+
+    PersistentFontFallbackCacheHeader header { fileMagic, fileVersion, static_cast<uint32_t>(FcGetVersion()), m_fontSetFingerprint, static_cast<uint32_t>(sortedEntries.size()), static_cast<uint32_t>(characters.size()), static_cast<uint32_t>(paths.size()), 0 };
+
+    if (!FileSystem::makeAllDirectories(m_directory))
+        return;
+
+    // Write to a file private to this process and move it in place, so readers never see a partial file.
+    auto path = cacheFilePath(m_directory);
+    auto temporaryPath = makeString(path, '.', getCurrentProcessID());
+    auto handle = FileSystem::openFile(temporaryPath, FileSystem::FileOpenMode::Write);
+    if (!FileSystem::isHandleValid(handle))
+        return;
+
+    bool wroteSuccessfully = writeAllToFile(handle, &header, 1)
+        && writeAllToFile(handle, sortedEntries.data(), sortedEntries.size())
+        && writeAllToFile(handle, characters.data(), characters.size())
+        && writeAllToFile(handle, paths.data(), paths.size());
+    FileSystem::closeFile(handle);
+    if (!wroteSuccessfully || !FileSystem::moveFile(temporaryPath, path)) {
+        FileSystem::deleteFile(temporaryPath);
+        return;
+    }
+
+    bool success = false;
+    FileSystem::MappedFileData file(path, FileSystem::MappedFileMode::Private, success);
+    if (!success)
+        return;
+    m_file = WTFMove(file);
+    m_addedEntries.clear();
+}
+
+} // namespace WebCore
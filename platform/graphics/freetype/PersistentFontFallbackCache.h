@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2020 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Timer.h"
+#include <wtf/FileSystem.h>
+#include <wtf/HashMap.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/RefPtr.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+typedef struct _FcPattern FcPattern;
+
+namespace WebCore {
+
+struct PersistentFontFallbackCacheEntry;
+
+// Remembers on disk which font Fontconfig picked as the system fallback for a string, so that a new
+// process can resolve fallback fonts without FcFontSort(). Entries are keyed by the hash of the
+// substituted Fontconfig request pattern and by the characters, and map to a font file and face index.
+// The file is memory mapped when first needed; new answers are kept in memory and merged into it shortly after.
+// The whole file is ignored when the set of installed fonts or the Fontconfig version changes.
+class PersistentFontFallbackCache {
+    WTF_MAKE_NONCOPYABLE(PersistentFontFallbackCache); WTF_MAKE_FAST_ALLOCATED;
+    friend NeverDestroyed<PersistentFontFallbackCache>;
+public:
+    static PersistentFontFallbackCache& singleton();
+
+    // An empty directory disables the cache. Defaults to a directory in the user cache directory.
+    WEBCORE_EXPORT static void setDirectory(const String&);
+
+    // Returns the render-ready pattern of the remembered fallback font, if it still covers all the characters.
+    RefPtr<FcPattern> fontForCharacters(FcPattern* requestPattern, unsigned requestPatternHash, const UChar*, unsigned length);
+    void add(unsigned requestPatternHash, const UChar*, unsigned length, FcPattern* resultPattern);
+
+    // Forgets the installed font set; it is scanned again on next use.
+    void clearFontSet();
+
+private:
+    PersistentFontFallbackCache();
+
+    struct FontFile {
+        CString path;
+        int index { 0 };
+    };
+
+    static uint64_t entryKey(unsigned requestPatternHash, const UChar*, unsigned length);
+    void ensureLoaded();
+    void ensureFontSet();
+    Optional<FontFile> lookup(unsigned requestPatternHash, const UChar*, unsigned length) const;
+    Optional<FontFile> fontFileForFileEntry(const PersistentFontFallbackCacheEntry&) const;
+    FcPattern* fontPatternForFile(const FontFile&);
+    void save();
+
+    String m_directory;
+    bool m_isLoaded { false };
+    bool m_isFontSetScanned { false };
+    unsigned m_fontSetFingerprint { 0 };
+    HashMap<std::pair<String, int>, FcPattern*> m_fontSet;
+    FileSystem::MappedFileData m_file;
+    // Keyed by the characters and the request pattern hash.
+    HashMap<std::pair<String, unsigned>, FontFile> m_addedEntries;
+    Timer m_saveTimer;
+};
+
+} // namespace WebCore
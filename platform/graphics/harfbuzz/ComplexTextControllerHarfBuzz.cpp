@@ -27,6 +27,7 @@
 #include "ComplexTextController.h"
 
 #include "CairoUtilities.h"
+#include "ComplexTextRunCache.h"
 #include "FontCascade.h"
 #include "FontTaggedSettings.h"
 #include "HbUniquePtr.h"
@@ -34,6 +35,7 @@
 #include <hb-ft.h>
 #include <hb-icu.h>
 #include <hb-ot.h>
+#include <wtf/MainThread.h>
 
 #if ENABLE(VARIATION_FONTS)
 #include FT_MULTIPLE_MASTERS_H
@@ -483,6 +485,24 @@ static hb_script_t findScriptForVerticalGlyphSubstitution(hb_face_t* face)
     return HB_SCRIPT_INVALID;
 }
 
+static ComplexTextRunCache::ShapedRun shapedRun(const ComplexTextController::ComplexTextRun& run)
+{
+    ComplexTextRunCache::ShapedRun shapedRun;
+    unsigned glyphCount = run.glyphCount();
+    shapedRun.glyphs.append(run.glyphs(), glyphCount);
+    shapedRun.baseAdvances.append(run.baseAdvances(), glyphCount);
+    if (auto* glyphOrigins = run.glyphOrigins())
+        shapedRun.glyphOrigins.append(glyphOrigins, glyphCount);
+    shapedRun.stringIndices.reserveInitialCapacity(glyphCount);
+    for (unsigned i = 0; i < glyphCount; ++i)
+        shapedRun.stringIndices.uncheckedAppend(run.indexAt(i));
+    shapedRun.initialAdvance = run.initialAdvance();
+    shapedRun.indexBegin = run.indexBegin();
+    shapedRun.indexEnd = run.indexEnd();
+    shapedRun.isLTR = run.isLTR();
+    return shapedRun;
+}
+
 void ComplexTextController::collectComplexTextRunsForCharacters(const UChar* characters, unsigned length, unsigned stringLocation, const Font* font)
 {
     if (!font) {
@@ -491,6 +511,24 @@ void ComplexTextController::collectComplexTextRunsForCharacters(const UChar* cha
         return;
     }
 
+    const auto& fontPlatformData = font->platformData();
+    auto features = fontFeatures(m_font, fontPlatformData);
+    bool shouldGuessDirection = m_mayUseNaturalWritingDirection && !m_run.directionalOverride();
+
+    Optional<ComplexTextRunCache::Key> cacheKey;
+    if (length <= ComplexTextRunCache::maximumTextLength && isMainThread()) {
+        cacheKey = ComplexTextRunCache::Key { String(characters, length), font, static_cast<unsigned>(m_run.rtl()) | (shouldGuessDirection ? 2 : 0), { } };
+        cacheKey->features.reserveInitialCapacity(features.size());
+        for (auto& feature : features)
+            cacheKey->features.uncheckedAppend({ feature.tag, feature.value });
+
+        if (auto* shapedRuns = ComplexTextRunCache::singleton().find(*cacheKey)) {
+            for (auto& run : *shapedRuns)
+                m_complexTextRuns.append(ComplexTextRun::create(run.baseAdvances, run.glyphOrigins, run.glyphs, run.stringIndices, run.initialAdvance, *font, characters, stringLocation, length, run.indexBegin, run.indexEnd, run.isLTR));
+            return;
+        }
+    }
+
     Vector<HBRun> runList;
     unsigned offset = 0;
     while (offset < length) {
@@ -505,7 +543,6 @@ void ComplexTextController::collectComplexTextRunsForCharacters(const UChar* cha
     if (!runCount)
         return;
 
-    const auto& fontPlatformData = font->platformData();
     auto* scaledFont = fontPlatformData.scaledFont();
     CairoFtFaceLocker cairoFtFaceLocker(scaledFont);
     FT_Face ftFace = cairoFtFaceLocker.ftFace();
@@ -540,7 +577,6 @@ void ComplexTextController::collectComplexTextRunsForCharacters(const UChar* cha
 
     hb_font_make_immutable(harfBuzzFont.get());
 
-    auto features = fontFeatures(m_font, fontPlatformData);
     HbUniquePtr<hb_buffer_t> buffer(hb_buffer_create());
     if (fontPlatformData.orientation() == FontOrientation::Vertical)
         hb_buffer_set_script(buffer.get(), findScriptForVerticalGlyphSubstitution(face.get()));
@@ -550,7 +586,7 @@ void ComplexTextController::collectComplexTextRunsForCharacters(const UChar* cha
 
         if (fontPlatformData.orientation() != FontOrientation::Vertical)
             hb_buffer_set_script(buffer.get(), hb_icu_script_to_script(run.script));
-        if (!m_mayUseNaturalWritingDirection || m_run.directionalOverride())
+        if (!shouldGuessDirection)
             hb_buffer_set_direction(buffer.get(), m_run.rtl() ? HB_DIRECTION_RTL : HB_DIRECTION_LTR);
         else {
             // Leaving direction to HarfBuzz to guess is *really* bad, but will do for now.
@@ -562,6 +598,15 @@ void ComplexTextController::collectComplexTextRunsForCharacters(const UChar* cha
         m_complexTextRuns.append(ComplexTextRun::create(buffer.get(), *font, characters, stringLocation, length, run.startIndex, run.endIndex));
         hb_buffer_reset(buffer.get());
     }
+
+    if (cacheKey) {
+        // Record the runs before adjustGlyphsAndAdvances() applies the per-controller adjustments to them.
+        ComplexTextRunCache::ShapedRuns shapedRuns;
+        shapedRuns.reserveInitialCapacity(runCount);
+        for (size_t i = m_complexTextRuns.size() - runCount; i < m_complexTextRuns.size(); ++i)
+            shapedRuns.uncheckedAppend(shapedRun(*m_complexTextRuns[i]));
+        ComplexTextRunCache::singleton().add(WTFMove(*cacheKey), WTFMove(shapedRuns));
+    }
 }
 
 } // namespace WebCore
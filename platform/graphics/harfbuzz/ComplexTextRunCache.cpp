@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2020 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ComplexTextRunCache.h"
+
+#if USE(HARFBUZZ)
+
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+ComplexTextRunCache& ComplexTextRunCache::singleton()
+{
+    ASSERT(isMainThread());
+    static NeverDestroyed<ComplexTextRunCache> cache;
+    return cache;
+}
+
+unsigned ComplexTextRunCache::KeyHash::hash(const Key& key)
+{
+    unsigned hash = pairIntHash(key.text.hash(), pairIntHash(PtrHash<const Font*>::hash(key.font), key.direction));
+    for (auto& feature : key.features)
+        hash = pairIntHash(hash, pairIntHash(feature.first, feature.second));
+    return hash;
+}
+
+auto ComplexTextRunCache::find(const Key& key) -> const ShapedRuns*
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        ++m_missCount;
+        return nullptr;
+    }
+
+    ++m_hitCount;
+    m_lruList.appendOrMoveToLast(it->key);
+    return &it->value;
+}
+
+void ComplexTextRunCache::add(Key&& key, ShapedRuns&& runs)
+{
+    if (!m_capacity || key.text.length() > maximumTextLength)
+        return;
+
+    m_lruList.appendOrMoveToLast(key);
+    m_entries.set(WTFMove(key), WTFMove(runs));
+    pruneToSize(m_capacity);
+}
+
+void ComplexTextRunCache::remove(const Font& font)
+{
+    m_entries.removeIf([&](auto& keyAndRuns) {
+        if (keyAndRuns.key.font != &font)
+            return false;
+        m_lruList.remove(keyAndRuns.key);
+        return true;
+    });
+}
+
+void ComplexTextRunCache::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    pruneToSize(m_capacity);
+}
+
+void ComplexTextRunCache::clear()
+{
+    m_entries.clear();
+    m_lruList.clear();
+}
+
+void ComplexTextRunCache::pruneToSize(size_t targetSize)
+{
+    while (m_entries.size() > targetSize) {
+        ASSERT(!m_lruList.isEmpty());
+        m_entries.remove(m_lruList.takeFirst());
+        ++m_evictionCount;
+    }
+}
+
+auto ComplexTextRunCache::statistics() const -> Statistics
+{
+    return { m_hitCount, m_missCount, m_evictionCount, size(), capacity() };
+}
+
+void ComplexTextRunCache::resetStatistics()
+{
+    m_hitCount = 0;
+    m_missCount = 0;
+    m_evictionCount = 0;
+}
+
+} // namespace WebCore
+
+#endif // USE(HARFBUZZ)
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 Igalia S.L.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if USE(HARFBUZZ)
+
+#include "FloatPoint.h"
+#include "FloatSize.h"
+#include "Glyph.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+class Font;
+
+// Remembers the HarfBuzz shaping results of recently shaped strings so that measuring,
+// painting and hit testing the same text does not shape it again. Only the output of
+// hb_shape() is kept; ComplexTextController rebuilds its runs from it for every use.
+class ComplexTextRunCache {
+    WTF_MAKE_NONCOPYABLE(ComplexTextRunCache); WTF_MAKE_FAST_ALLOCATED;
+    friend NeverDestroyed<ComplexTextRunCache>;
+public:
+    struct Key {
+        String text;
+        const Font* font { nullptr };
+        // Whether the direction was forced or guessed by HarfBuzz, and the run order.
+        unsigned direction { 0 };
+        // OpenType feature tags and values, as passed to hb_shape().
+        Vector<std::pair<uint32_t, uint32_t>> features;
+
+        bool operator==(const Key& other) const { return font == other.font && direction == other.direction && text == other.text && features == other.features; }
+    };
+
+    struct ShapedRun {
+        Vector<Glyph> glyphs;
+        Vector<FloatSize> baseAdvances;
+        Vector<FloatPoint> glyphOrigins;
+        Vector<unsigned> stringIndices;
+        FloatSize initialAdvance;
+        unsigned indexBegin { 0 };
+        unsigned indexEnd { 0 };
+        bool isLTR { true };
+    };
+    using ShapedRuns = Vector<ShapedRun>;
+
+    struct Statistics {
+        unsigned hitCount { 0 };
+        unsigned missCount { 0 };
+        unsigned evictionCount { 0 };
+        size_t size { 0 };
+        size_t capacity { 0 };
+    };
+
+    // Longer strings are rarely shaped twice and would crowd out the short words that are.
+    static constexpr unsigned maximumTextLength = 256;
+
+    WEBCORE_EXPORT static ComplexTextRunCache& singleton();
+
+    const ShapedRuns* find(const Key&);
+    void add(Key&&, ShapedRuns&&);
+    void remove(const Font&);
+
+    WEBCORE_EXPORT void setCapacity(size_t);
+    size_t capacity() const { return m_capacity; }
+    size_t size() const { return m_entries.size(); }
+    WEBCORE_EXPORT void clear();
+
+    WEBCORE_EXPORT Statistics statistics() const;
+    WEBCORE_EXPORT void resetStatistics();
+
+private:
+    ComplexTextRunCache() = default;
+
+    struct KeyHash {
+        static unsigned hash(const Key&);
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = false;
+    };
+
+    struct KeyTraits : GenericHashTraits<Key> {
+        static const bool emptyValueIsZero = true;
+        static void constructDeletedValue(Key& slot)
+        {
+            new (NotNull, &slot) Key;
+            slot.font = reinterpret_cast<const Font*>(-1);
+        }
+        static bool isDeletedValue(const Key& key) { return key.font == reinterpret_cast<const Font*>(-1); }
+    };
+
+    void pruneToSize(size_t);
+
+    HashMap<Key, ShapedRuns, KeyHash, KeyTraits> m_entries;
+    // Keys of the cached entries, least recently used first.
+    ListHashSet<Key, KeyHash> m_lruList;
+
+    size_t m_capacity { 1024 };
+
+    unsigned m_hitCount { 0 };
+    unsigned m_missCount { 0 };
+    unsigned m_evictionCount { 0 };
+};
+
+} // namespace WebCore
+
+#endif // USE(HARFBUZZ)
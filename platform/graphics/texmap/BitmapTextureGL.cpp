@@ -210,6 +210,23 @@ static unsigned getPassesRequiredForFilter(FilterOperation::OperationType type)
     }
 }
 
+// The blur shader uses a fixed number of taps spread over the standard deviation, so large blurs are
+// computed on a downsampled copy of the content. This keeps the taps dense enough to avoid banding and
+// shades a fraction of the pixels; the result is scaled back up when the surface is composited.
+static const float MaximumBlurStdDeviation = 8;
+static const unsigned MaximumBlurDownsamplingSteps = 3;
+
+static unsigned blurDownsamplingSteps(float stdDeviation, const IntSize& size)
+{
+    unsigned steps = 0;
+    while (stdDeviation > MaximumBlurStdDeviation && steps < MaximumBlurDownsamplingSteps
+        && size.width() >> (steps + 1) && size.height() >> (steps + 1)) {
+        stdDeviation /= 2;
+        ++steps;
+    }
+    return steps;
+}
+
 RefPtr<BitmapTexture> BitmapTextureGL::applyFilters(TextureMapper& textureMapper, const FilterOperations& filters)
 {
     if (filters.isEmpty())
@@ -220,6 +237,7 @@ RefPtr<BitmapTexture> BitmapTextureGL::applyFilters(TextureMapper& textureMapper
     RefPtr<BitmapTexture> resultSurface = this;
     RefPtr<BitmapTexture> intermediateSurface;
     RefPtr<BitmapTexture> spareSurface;
+    IntSize originalSize = contentSize();
 
     m_filterInfo = FilterInfo();
 
@@ -227,12 +245,30 @@ RefPtr<BitmapTexture> BitmapTextureGL::applyFilters(TextureMapper& textureMapper
         RefPtr<FilterOperation> filter = filters.operations()[i];
         ASSERT(filter);
 
+        bool isDownsampled = false;
+        if (filter->type() == FilterOperation::BLUR) {
+            float stdDeviation = floatValueForLength(static_cast<const BlurFilterOperation&>(*filter).stdDeviation(), 0);
+            if (unsigned steps = blurDownsamplingSteps(stdDeviation, resultSurface->contentSize())) {
+                for (unsigned step = 0; step < steps; ++step) {
+                    IntSize halfSize(resultSurface->contentSize().width() / 2, resultSurface->contentSize().height() / 2);
+                    RefPtr<BitmapTexture> downsampledSurface = texmapGL.acquireTextureFromPool(halfSize, BitmapTexture::SupportsAlpha);
+                    texmapGL.bindSurface(downsampledSurface.get());
+                    texmapGL.drawTexture(*resultSurface, FloatRect(FloatPoint::zero(), halfSize), TransformationMatrix(), 1, TextureMapper::AllEdges);
+                    resultSurface = WTFMove(downsampledSurface);
+                }
+                intermediateSurface = nullptr;
+                filter = BlurFilterOperation::create(Length(stdDeviation / (1 << steps), Fixed));
+                isDownsampled = true;
+            }
+        }
+
         int numPasses = getPassesRequiredForFilter(filter->type());
         for (int j = 0; j < numPasses; ++j) {
-            bool last = (i == filters.size() - 1) && (j == numPasses - 1);
+            // A downsampled blur runs all its passes here, so that the result can be scaled back up below.
+            bool last = !isDownsampled && (i == filters.size() - 1) && (j == numPasses - 1);
             if (!last) {
                 if (!intermediateSurface)
-                    intermediateSurface = texmapGL.acquireTextureFromPool(contentSize(), BitmapTexture::SupportsAlpha);
+                    intermediateSurface = texmapGL.acquireTextureFromPool(resultSurface->contentSize(), BitmapTexture::SupportsAlpha);
                 texmapGL.bindSurface(intermediateSurface.get());
             }
 
@@ -248,6 +284,16 @@ RefPtr<BitmapTexture> BitmapTextureGL::applyFilters(TextureMapper& textureMapper
             }
             std::swap(resultSurface, intermediateSurface);
         }
+
+        if (isDownsampled) {
+            // Later filters and callers drawing into the returned surface, such as the replica path of
+            // TextureMapperLayer, work with the original size and offsets.
+            RefPtr<BitmapTexture> upsampledSurface = texmapGL.acquireTextureFromPool(originalSize, BitmapTexture::SupportsAlpha);
+            texmapGL.bindSurface(upsampledSurface.get());
+            texmapGL.drawTexture(*resultSurface, FloatRect(FloatPoint::zero(), originalSize), TransformationMatrix(), 1, TextureMapper::AllEdges);
+            resultSurface = WTFMove(upsampledSurface);
+            intermediateSurface = nullptr;
+        }
     }
 
     texmapGL.bindSurface(previousSurface.get());
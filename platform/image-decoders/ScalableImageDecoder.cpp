@@ -175,13 +175,12 @@ bool ScalableImageDecoder::frameHasAlphaAtIndex(size_t index) const
     return frame.hasAlpha();
 }
 
-unsigned ScalableImageDecoder::frameBytesAtIndex(size_t index, SubsamplingLevel) const
+unsigned ScalableImageDecoder::frameBytesAtIndex(size_t index, SubsamplingLevel subsamplingLevel) const
 {
     LockHolder lockHolder(m_mutex);
     if (m_frameBufferCache.size() <= index)
         return 0;
-    // FIXME: Use the dimension of the requested frame.
-    return (m_size.area() * sizeof(uint32_t)).unsafeGet();
+    return (frameSizeAtIndex(index, subsamplingLevel).area() * sizeof(uint32_t)).unsafeGet();
 }
 
 Seconds ScalableImageDecoder::frameDurationAtIndex(size_t index) const
@@ -204,13 +203,16 @@ Seconds ScalableImageDecoder::frameDurationAtIndex(size_t index) const
     return duration;
 }
 
-PlatformImagePtr ScalableImageDecoder::createFrameImageAtIndex(size_t index, SubsamplingLevel, const DecodingOptions&)
+PlatformImagePtr ScalableImageDecoder::createFrameImageAtIndex(size_t index, SubsamplingLevel subsamplingLevel, const DecodingOptions&)
 {
     LockHolder lockHolder(m_mutex);
     // Zero-height images can cause problems for some ports. If we have an empty image dimension, just bail.
     if (size().isEmpty())
         return nullptr;
 
+    if (frameAllowSubsamplingAtIndex(index))
+        setSubsamplingLevel(subsamplingLevel);
+
     auto* buffer = frameBufferAtIndex(index);
     if (!buffer || buffer->isInvalid() || !buffer->hasBackingStore())
         return nullptr;
@@ -76,7 +76,9 @@ public:
         if (m_encodedDataStatus == EncodedDataStatus::Error)
             return;
 
-        if (data.data()) {
+        if (canDecodeSegmentedData())
+            m_segmentedData = SharedBufferSegmentReader(data);
+        else if (data.data()) {
             // SharedBuffer::data() combines all segments into one in case there's more than one.
             m_data = data.begin()->segment.copyRef();
         }
@@ -153,6 +155,10 @@ public:
 
     bool frameAllowSubsamplingAtIndex(size_t) const override { return false; }
 
+    // Decoders which can produce a frame directly at a reduced size (e.g. JPEG through
+    // DCT scaling) override this to restart decoding when the requested level changes.
+    virtual void setSubsamplingLevel(SubsamplingLevel) { }
+
     enum { ICCColorProfileHeaderLength = 128 };
 
     static bool rgbColorProfile(const char* profileData, unsigned profileLength)
@@ -195,7 +201,12 @@ public:
     Optional<IntPoint> hotSpot() const override { return WTF::nullopt; }
 
 protected:
+    // Decoders which feed their library incrementally can read m_segmentedData instead of m_data.
+    // This saves combining the SharedBuffer into one segment every time more data arrives.
+    virtual bool canDecodeSegmentedData() const { return false; }
+
     RefPtr<SharedBuffer::DataSegment> m_data;
+    SharedBufferSegmentReader m_segmentedData;
     Vector<ScalableImageDecoderFrame, 1> m_frameBufferCache;
     mutable Lock m_mutex;
     bool m_premultiplyAlpha;
@@ -311,8 +311,9 @@ public:
 
             m_state = JPEG_START_DECOMPRESS;
 
-            // We can fill in the size now that the header is available.
-            if (!m_decoder->setSize(IntSize(m_info.image_width, m_info.image_height)))
+            // We can fill in the size now that the header is available. The header is
+            // read again when decoding restarts at a different subsampling level.
+            if (!m_decoder->isSizeAvailable() && !m_decoder->setSize(IntSize(m_info.image_width, m_info.image_height)))
                 return false;
 
             m_decoder->setOrientation(readImageOrientation(info()));
@@ -350,6 +351,11 @@ public:
             m_info.enable_2pass_quant = FALSE;
             m_info.do_block_smoothing = TRUE;
 
+            // jpeg_start_decompress() recomputes the output dimensions, so the
+            // samples buffer allocated for the unscaled width is large enough.
+            m_info.scale_num = 1;
+            m_info.scale_denom = m_decoder->scaleDenominator();
+
             // Start decompressor.
             if (!jpeg_start_decompress(&m_info))
                 return false; // I/O suspension.
@@ -506,6 +512,29 @@ ScalableImageDecoderFrame* JPEGImageDecoder::frameBufferAtIndex(size_t index)
     return &frame;
 }
 
+IntSize JPEGImageDecoder::frameSizeAtIndex(size_t, SubsamplingLevel subsamplingLevel) const
+{
+    if (!isSizeAvailable())
+        return { };
+
+    // Matches the rounding jpeg_calc_output_dimensions() applies to scaled output.
+    unsigned denominator = 1 << static_cast<unsigned>(subsamplingLevel);
+    IntSize size = this->size();
+    return { static_cast<int>((size.width() + denominator - 1) / denominator), static_cast<int>((size.height() + denominator - 1) / denominator) };
+}
+
+void JPEGImageDecoder::setSubsamplingLevel(SubsamplingLevel subsamplingLevel)
+{
+    if (subsamplingLevel == m_subsamplingLevel)
+        return;
+
+    // A frame is only ever decoded at a single scale, so switching levels drops the
+    // decoded frame and restarts decoding from the header.
+    m_subsamplingLevel = subsamplingLevel;
+    m_frameBufferCache.clear();
+    m_reader = nullptr;
+}
+
 bool JPEGImageDecoder::setFailed()
 {
     m_reader = nullptr;
@@ -568,8 +597,9 @@ bool JPEGImageDecoder::outputScanlines()
 
     // Initialize the framebuffer if needed.
     auto& buffer = m_frameBufferCache[0];
+    jpeg_decompress_struct* info = m_reader->info();
     if (buffer.isInvalid()) {
-        if (!buffer.initialize(size(), m_premultiplyAlpha))
+        if (!buffer.initialize(IntSize(info->output_width, info->output_height), m_premultiplyAlpha))
             return setFailed();
         buffer.setDecodingStatus(DecodingStatus::Partial);
         // The buffer is transparent outside the decoded area while the image is
@@ -577,8 +607,6 @@ bool JPEGImageDecoder::outputScanlines()
         buffer.setHasAlpha(true);
     }
 
-    jpeg_decompress_struct* info = m_reader->info();
-
 #if defined(TURBO_JPEG_RGB_SWIZZLE)
     if (turboSwizzled(info->out_color_space)) {
         while (info->output_scanline < info->output_height) {
@@ -53,6 +53,9 @@ namespace WebCore {
         // ScalableImageDecoder
         String filenameExtension() const override { return "jpg"_s; }
         ScalableImageDecoderFrame* frameBufferAtIndex(size_t index) override;
+        IntSize frameSizeAtIndex(size_t, SubsamplingLevel) const override;
+        bool frameAllowSubsamplingAtIndex(size_t) const override { return true; }
+        void setSubsamplingLevel(SubsamplingLevel) override;
         // CAUTION: setFailed() deletes |m_reader|.  Be careful to avoid
         // accessing deleted memory, especially when calling this from inside
         // JPEGImageReader!
@@ -63,6 +66,10 @@ namespace WebCore {
 
         void setOrientation(ImageOrientation orientation) { m_orientation = orientation; }
 
+        // libjpeg scales in the DCT domain by 1/2, 1/4 or 1/8, which maps directly onto
+        // the subsampling levels, so a scaled-down frame never exists at full size.
+        unsigned scaleDenominator() const { return 1 << static_cast<unsigned>(m_subsamplingLevel); }
+
     private:
         JPEGImageDecoder(AlphaOption, GammaAndColorProfileOption);
         void tryDecodeSize(bool allDataReceived) override { decode(true, allDataReceived); }
@@ -79,6 +86,7 @@ namespace WebCore {
         bool outputScanlines(ScalableImageDecoderFrame& buffer);
 
         std::unique_ptr<JPEGImageReader> m_reader;
+        SubsamplingLevel m_subsamplingLevel { SubsamplingLevel::Default };
     };
 
 } // namespace WebCore
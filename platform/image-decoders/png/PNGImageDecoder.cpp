@@ -120,6 +120,7 @@ public:
         : m_readOffset(0)
         , m_currentBufferSize(0)
         , m_decodingSizeOnly(false)
+        , m_haltedAfterHeader(false)
         , m_hasAlpha(false)
     {
         m_png = png_create_read_struct(PNG_LIBPNG_VER_STRING, 0, decodingFailed, decodingWarning);
@@ -147,20 +148,27 @@ public:
         m_readOffset = 0;
     }
 
-    bool decode(const SharedBuffer::DataSegment& data, bool sizeOnly, unsigned haltAtFrame)
+    bool decode(const SharedBufferSegmentReader& data, bool sizeOnly, unsigned haltAtFrame)
     {
         m_decodingSizeOnly = sizeOnly;
+        m_haltedAfterHeader = false;
         PNGImageDecoder* decoder = static_cast<PNGImageDecoder*>(png_get_progressive_ptr(m_png));
 
         // We need to do the setjmp here. Otherwise bad things will happen.
         if (setjmp(JMPBUF(m_png)))
             return decoder->setFailed();
 
-        auto bytesToSkip = m_readOffset;
-        auto bytesToUse = data.size() - bytesToSkip;
-        m_readOffset += bytesToUse;
-        m_currentBufferSize = m_readOffset;
-        png_process_data(m_png, m_info, reinterpret_cast<png_bytep>(const_cast<char*>(data.data() + bytesToSkip)), bytesToUse);
+        // libpng accepts the data in pieces, so hand it the segments as they are. When
+        // headerAvailable() halts the reader it moves m_readOffset back to the first byte
+        // libpng did not process, and the remaining data is left for the next call. The header
+        // may end exactly at a segment boundary, so the halt is tracked separately rather than
+        // inferred from the offset.
+        data.forEachSegment(m_readOffset, [this](const char* segment, size_t length) {
+            m_readOffset += length;
+            m_currentBufferSize = m_readOffset;
+            png_process_data(m_png, m_info, reinterpret_cast<png_bytep>(const_cast<char*>(segment)), length);
+            return !m_haltedAfterHeader;
+        });
         // We explicitly specify the superclass encodedDataStatus() because we
         // merely want to check if we've managed to set the size, not
         // (recursively) trigger additional decoding if we haven't.
@@ -174,6 +182,7 @@ public:
     png_infop infoPtr() const { return m_info; }
 
     void setReadOffset(unsigned offset) { m_readOffset = offset; }
+    void haltAfterHeader() { m_haltedAfterHeader = true; }
     unsigned currentBufferSize() const { return m_currentBufferSize; }
     bool decodingSizeOnly() const { return m_decodingSizeOnly; }
     void setHasAlpha(bool hasAlpha) { m_hasAlpha = hasAlpha; }
@@ -188,6 +197,7 @@ private:
     unsigned m_readOffset;
     unsigned m_currentBufferSize;
     bool m_decodingSizeOnly;
+    bool m_haltedAfterHeader;
     bool m_hasAlpha;
     UniqueArray<png_byte> m_interlaceBuffer;
 };
@@ -402,6 +412,7 @@ void PNGImageDecoder::headerAvailable()
         m_reader->setReadOffset(m_reader->currentBufferSize() - png->buffer_size);
         png->buffer_size = 0;
 #endif
+        m_reader->haltAfterHeader();
     }
 }
 
@@ -542,7 +553,7 @@ void PNGImageDecoder::decode(bool onlySize, unsigned haltAtFrame, bool allDataRe
 
     // If we couldn't decode the image but we've received all the data, decoding
     // has failed.
-    if (!m_reader->decode(*m_data, onlySize, haltAtFrame) && allDataReceived)
+    if (!m_reader->decode(m_segmentedData, onlySize, haltAtFrame) && allDataReceived)
         setFailed();
     // If we're done decoding the image, we don't need the PNGImageReader
     // anymore.  (If we failed, |m_reader| has already been cleared.)
@@ -89,6 +89,7 @@ namespace WebCore {
     private:
         PNGImageDecoder(AlphaOption, GammaAndColorProfileOption);
         void tryDecodeSize(bool allDataReceived) override { decode(true, 0, allDataReceived); }
+        bool canDecodeSegmentedData() const override { return true; }
 
         // Decodes the image.  If |onlySize| is true, stops decoding after
         // calculating the image size.  If decoding fails but there is no more
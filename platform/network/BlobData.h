@@ -61,6 +61,7 @@ public:
 
 private:
     friend class BlobData;
+    friend class BlobRegistryImpl;
 
     explicit BlobDataItem(Ref<BlobDataFileReference>&& file)
         : m_type(Type::File)
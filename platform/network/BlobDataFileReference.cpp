@@ -38,10 +38,22 @@ BlobDataFileReference::BlobDataFileReference(const String& path, const String& r
 {
 }
 
+Ref<BlobDataFileReference> BlobDataFileReference::createForSpilledData(const String& path, unsigned long long size)
+{
+    auto reference = adoptRef(*new BlobDataFileReference(path, { }));
+    reference->m_isSpilledData = true;
+    reference->m_size = size;
+    return reference;
+}
+
 BlobDataFileReference::~BlobDataFileReference()
 {
     if (!m_replacementPath.isNull())
         FileSystem::deleteFile(m_replacementPath);
+    if (m_isSpilledData) {
+        m_mappedData = { };
+        FileSystem::deleteFile(m_path);
+    }
 }
 
 const String& BlobDataFileReference::path()
@@ -77,6 +89,20 @@ Optional<WallTime> BlobDataFileReference::expectedModificationTime()
     return m_expectedModificationTime;
 }
 
+const uint8_t* BlobDataFileReference::mappedData()
+{
+    if (!m_isSpilledData || !m_size)
+        return nullptr;
+
+    if (!m_mappedData) {
+        bool success;
+        m_mappedData = FileSystem::MappedFileData(m_path, FileSystem::MappedFileMode::Shared, success);
+        if (!success)
+            return nullptr;
+    }
+    return static_cast<const uint8_t*>(m_mappedData.data());
+}
+
 void BlobDataFileReference::startTrackingModifications()
 {
     // This is not done automatically by the constructor, because BlobDataFileReference is
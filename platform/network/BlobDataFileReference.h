@@ -26,6 +26,7 @@
 #ifndef BlobDataFileReference_h
 #define BlobDataFileReference_h
 
+#include <wtf/FileSystem.h>
 #include <wtf/Markable.h>
 #include <wtf/RefCounted.h>
 #include <wtf/WallTime.h>
@@ -40,6 +41,9 @@ public:
         return adoptRef(*new BlobDataFileReference(path, replacementPath));
     }
 
+    // A temporary file holding blob bytes that BlobRegistryImpl moved out of memory. The file is deleted along with the reference.
+    static Ref<BlobDataFileReference> createForSpilledData(const String& path, unsigned long long size);
+
     virtual ~BlobDataFileReference();
 
     void startTrackingModifications();
@@ -48,6 +52,10 @@ public:
     unsigned long long size();
     Optional<WallTime> expectedModificationTime();
 
+    bool isSpilledData() const { return m_isSpilledData; }
+    // Maps spilled data on first use. Returns null for other files, or if the mapping failed.
+    const uint8_t* mappedData();
+
     virtual void prepareForFileAccess();
     virtual void revokeFileAccess();
 
@@ -65,6 +73,8 @@ private:
     bool m_replacementShouldBeGenerated { false };
 #endif
     unsigned long long m_size { 0 };
+    bool m_isSpilledData { false };
+    FileSystem::MappedFileData m_mappedData;
     Markable<WallTime, WallTime::MarkableTraits> m_expectedModificationTime;
 };
 
@@ -119,12 +119,116 @@ void BlobRegistryImpl::registerFileBlobURL(const URL& url, Ref<BlobDataFileRefer
     m_blobs.set(url.string(), WTFMove(blobData));
 }
 
+// FileSystem::writeToFile takes an int length, so larger buffers are written in pieces.
+static bool writeBytesToFile(FileSystem::PlatformFileHandle file, const uint8_t* data, size_t length)
+{
+    constexpr size_t maximumWriteSize = 1 << 30;
+    while (length) {
+        int writeSize = static_cast<int>(std::min(length, maximumWriteSize));
+        if (FileSystem::writeToFile(file, reinterpret_cast<const char*>(data), writeSize) != writeSize)
+            return false;
+        data += writeSize;
+        length -= writeSize;
+    }
+    return true;
+}
+
+static WorkQueue& blobUtilityQueue()
+{
+    static auto& queue = WorkQueue::create("org.webkit.BlobUtility", WorkQueue::Type::Serial, WorkQueue::QOS::Utility).leakRef();
+    return queue;
+}
+
+// Writes the data buffers, in order, to a single temporary file on the utility queue. Once the write
+// completes, every registered blob that references one of the buffers gets a File item for the same
+// range of the file instead, so the buffers are released when the last reader lets go of them.
+void BlobRegistryImpl::spillDataToFile(Vector<ThreadSafeDataBuffer>&& dataToSpill, size_t dataSize)
+{
+    ASSERT(isMainThread());
+    blobUtilityQueue().dispatch([weakThis = makeWeakPtr(*this), dataToSpill = WTFMove(dataToSpill), dataSize]() mutable {
+        FileSystem::PlatformFileHandle file;
+        String path = FileSystem::openTemporaryFile("BlobData"_s, file);
+        if (path.isEmpty() || !FileSystem::isHandleValid(file)) {
+            LOG_ERROR("Failed to open temporary file for Blob data, keeping it in memory");
+            return;
+        }
+
+        bool success = true;
+        for (auto& data : dataToSpill) {
+            if (!writeBytesToFile(file, data.data()->data(), data.size())) {
+                LOG_ERROR("Failed writing Blob data to temporary file, keeping it in memory");
+                success = false;
+                break;
+            }
+        }
+        FileSystem::closeFile(file);
+        if (!success) {
+            FileSystem::deleteFile(path);
+            return;
+        }
+
+        callOnMainThread([weakThis = WTFMove(weakThis), dataToSpill = WTFMove(dataToSpill), path = path.isolatedCopy(), dataSize] {
+            if (!weakThis) {
+                FileSystem::deleteFile(path);
+                return;
+            }
+            // Dropping the last reference to the file, e.g. if all blobs were unregistered meanwhile, deletes it.
+            weakThis->swapInSpilledData(dataToSpill, BlobDataFileReference::createForSpilledData(path, dataSize));
+        });
+    });
+}
+
+void BlobRegistryImpl::swapInSpilledData(const Vector<ThreadSafeDataBuffer>& spilledData, Ref<BlobDataFileReference>&& file)
+{
+    ASSERT(isMainThread());
+
+    HashMap<const Vector<uint8_t>*, long long> fileOffsets;
+    long long fileOffset = 0;
+    for (auto& data : spilledData) {
+        fileOffsets.add(data.data(), fileOffset);
+        fileOffset += data.size();
+    }
+
+    // Slices and blobs built from this one hold the same buffers, so they are switched over as well.
+    // Readers may still be using the old BlobData, so a new one replaces it rather than changing its items.
+    HashMap<BlobData*, RefPtr<BlobData>> replacements;
+    for (auto& blobData : m_blobs.values()) {
+        if (replacements.contains(blobData.get()))
+            continue;
+
+        bool referencesSpilledData = WTF::anyOf(blobData->items(), [&](auto& item) {
+            return item.type() == BlobDataItem::Type::Data && fileOffsets.contains(item.data().data());
+        });
+        if (!referencesSpilledData) {
+            replacements.add(blobData.get(), nullptr);
+            continue;
+        }
+
+        auto newData = BlobData::create(blobData->contentType());
+        for (auto& item : blobData->items()) {
+            auto offset = item.type() == BlobDataItem::Type::Data ? fileOffsets.find(item.data().data()) : fileOffsets.end();
+            if (offset != fileOffsets.end())
+                newData->appendFile(file.ptr(), offset->value + item.offset(), item.length());
+            else
+                newData->m_items.append(item);
+        }
+        replacements.add(blobData.get(), WTFMove(newData));
+    }
+
+    for (auto& blobData : m_blobs.values()) {
+        if (auto* replacement = replacements.get(blobData.get()))
+            blobData = replacement;
+    }
+}
+
 void BlobRegistryImpl::registerBlobURL(const URL& url, Vector<BlobPart>&& blobParts, const String& contentType)
 {
     ASSERT(isMainThread());
     registerBlobResourceHandleConstructor();
 
     auto blobData = BlobData::create(contentType);
+    Vector<ThreadSafeDataBuffer> dataToSpill;
+    size_t dataSize = 0;
 
     // The blob data is stored in the "canonical" way. That is, it only contains a list of Data and File items.
     // 1) The Data item is denoted by the raw data and the range.
@@ -138,6 +242,8 @@ void BlobRegistryImpl::registerBlobURL(const URL& url, Vector<BlobPart>&& blobPa
             auto movedData = part.moveData();
             auto data = ThreadSafeDataBuffer::create(WTFMove(movedData));
             blobData->appendData(data);
+            dataSize += data.size();
+            dataToSpill.append(WTFMove(data));
             break;
         }
         case BlobPart::Type::Blob: {
@@ -151,6 +257,10 @@ void BlobRegistryImpl::registerBlobURL(const URL& url, Vector<BlobPart>&& blobPa
     }
 
     m_blobs.set(url.string(), WTFMove(blobData));
+
+    // The blob is usable right away; its data moves to a file in the background.
+    if (m_fileBackingThreshold && dataSize >= m_fileBackingThreshold)
+        spillDataToFile(WTFMove(dataToSpill), dataSize);
 }
 
 void BlobRegistryImpl::registerBlobURL(const URL& url, const URL& srcURL)
@@ -242,12 +352,6 @@ unsigned long long BlobRegistryImpl::blobSize(const URL& url)
     return result;
 }
 
-static WorkQueue& blobUtilityQueue()
-{
-    static auto& queue = WorkQueue::create("org.webkit.BlobUtility", WorkQueue::Type::Serial, WorkQueue::QOS::Utility).leakRef();
-    return queue;
-}
-
 bool BlobRegistryImpl::populateBlobsForFileWriting(const Vector<String>& blobURLs, Vector<BlobForFileWriting>& blobsForWriting)
 {
     for (auto& url : blobURLs) {
@@ -261,10 +365,10 @@ bool BlobRegistryImpl::populateBlobsForFileWriting(const Vector<String>& blobURL
         for (auto& item : blobData->items()) {
             switch (item.type()) {
             case BlobDataItem::Type::Data:
-                blobsForWriting.last().filePathsOrDataBuffers.append({ { }, item.data() });
+                blobsForWriting.last().parts.append({ { }, item.data(), item.offset(), item.length(), nullptr });
                 break;
             case BlobDataItem::Type::File:
-                blobsForWriting.last().filePathsOrDataBuffers.append({ item.file()->path().isolatedCopy(), { } });
+                blobsForWriting.last().parts.append({ item.file()->path().isolatedCopy(), { }, item.offset(), item.m_length, item.file() });
                 break;
             default:
                 ASSERT_NOT_REACHED();
@@ -274,7 +378,37 @@ bool BlobRegistryImpl::populateBlobsForFileWriting(const Vector<String>& blobURL
     return true;
 }
 
-static bool writeFilePathsOrDataBuffersToFile(const Vector<std::pair<String, ThreadSafeDataBuffer>>& filePathsOrDataBuffers, FileSystem::PlatformFileHandle file, const String& path)
+static bool appendFileRangeToFileHandle(const String& sourcePath, long long offset, long long length, FileSystem::PlatformFileHandle file)
+{
+    if (!offset && length == BlobDataItem::toEndOfFile)
+        return FileSystem::appendFileContentsToFileHandle(sourcePath, file);
+    if (length < 0)
+        return false;
+
+    auto sourceFile = FileSystem::openFile(sourcePath, FileSystem::FileOpenMode::Read);
+    if (!FileSystem::isHandleValid(sourceFile))
+        return false;
+    auto sourceFileCloser = WTF::makeScopeExit([sourceFile]() mutable {
+        FileSystem::closeFile(sourceFile);
+    });
+
+    if (FileSystem::seekFile(sourceFile, offset, FileSystem::FileSeekOrigin::Beginning) < 0)
+        return false;
+
+    constexpr int bufferSize = 64 * 1024;
+    Vector<uint8_t> buffer(bufferSize);
+    while (length) {
+        int readSize = static_cast<int>(std::min<long long>(length, bufferSize));
+        if (FileSystem::readFromFile(sourceFile, reinterpret_cast<char*>(buffer.data()), readSize) != readSize)
+            return false;
+        if (!writeBytesToFile(file, buffer.data(), readSize))
+            return false;
+        length -= readSize;
+    }
+    return true;
+}
+
+static bool writeBlobPartsToFile(const Vector<BlobRegistryImpl::BlobForFileWriting::Part>& parts, FileSystem::PlatformFileHandle file, const String& path)
 {
     auto fileCloser = WTF::makeScopeExit([file]() mutable {
         FileSystem::closeFile(file);
@@ -285,17 +419,17 @@ static bool writeFilePathsOrDataBuffersToFile(const Vector<std::pair<String, Thr
         return false;
     }
 
-    for (auto& part : filePathsOrDataBuffers) {
-        if (part.second.data()) {
-            int length = part.second.data()->size();
-            if (FileSystem::writeToFile(file, reinterpret_cast<const char*>(part.second.data()->data()), length) != length) {
+    for (auto& part : parts) {
+        if (part.data.data()) {
+            ASSERT(part.offset >= 0 && part.length >= 0 && static_cast<unsigned long long>(part.offset + part.length) <= part.data.data()->size());
+            if (!writeBytesToFile(file, part.data.data()->data() + part.offset, part.length)) {
                 LOG_ERROR("Failed writing a Blob to temporary file");
                 return false;
             }
         } else {
-            ASSERT(!part.first.isEmpty());
-            if (!FileSystem::appendFileContentsToFileHandle(part.first, file)) {
-                LOG_ERROR("Failed copying File contents to a Blob temporary file (%s to %s)", part.first.utf8().data(), path.utf8().data());
+            ASSERT(!part.filePath.isEmpty());
+            if (!appendFileRangeToFileHandle(part.filePath, part.offset, part.length, file)) {
+                LOG_ERROR("Failed copying File contents to a Blob temporary file (%s to %s)", part.filePath.utf8().data(), path.utf8().data());
                 return false;
             }
         }
@@ -316,14 +450,15 @@ void BlobRegistryImpl::writeBlobsToTemporaryFiles(const Vector<String>& blobURLs
         for (auto& blob : blobsForWriting) {
             FileSystem::PlatformFileHandle file;
             String tempFilePath = FileSystem::openTemporaryFile("Blob"_s, file);
-            if (!writeFilePathsOrDataBuffersToFile(blob.filePathsOrDataBuffers, file, tempFilePath)) {
+            if (!writeBlobPartsToFile(blob.parts, file, tempFilePath)) {
                 filePaths.clear();
                 break;
             }
             filePaths.append(tempFilePath.isolatedCopy());
         }
 
-        callOnMainThread([completionHandler = WTFMove(completionHandler), filePaths = WTFMove(filePaths)] () mutable {
+        // The file references are only safe to release on the main thread.
+        callOnMainThread([blobsForWriting = WTFMove(blobsForWriting), completionHandler = WTFMove(completionHandler), filePaths = WTFMove(filePaths)] () mutable {
             completionHandler(WTFMove(filePaths));
         });
     });
@@ -338,8 +473,9 @@ void BlobRegistryImpl::writeBlobToFilePath(const URL& blobURL, const String& pat
     }
 
     blobUtilityQueue().dispatch([path, blobsForWriting = WTFMove(blobsForWriting), completionHandler = WTFMove(completionHandler)]() mutable {
-        bool success = writeFilePathsOrDataBuffersToFile(blobsForWriting.first().filePathsOrDataBuffers, FileSystem::openFile(path, FileSystem::FileOpenMode::Write), path);
-        callOnMainThread([success, completionHandler = WTFMove(completionHandler)]() {
+        bool success = writeBlobPartsToFile(blobsForWriting.first().parts, FileSystem::openFile(path, FileSystem::FileOpenMode::Write), path);
+        // The file references are only safe to release on the main thread.
+        callOnMainThread([success, blobsForWriting = WTFMove(blobsForWriting), completionHandler = WTFMove(completionHandler)]() {
             completionHandler(success);
         });
     });
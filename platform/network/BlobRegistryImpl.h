@@ -35,6 +35,7 @@
 #include "BlobRegistry.h"
 #include <wtf/HashMap.h>
 #include <wtf/URLHash.h>
+#include <wtf/WeakPtr.h>
 #include <wtf/text/StringHash.h>
 #include <wtf/text/WTFString.h>
 
@@ -46,7 +47,7 @@ class ResourceRequest;
 class ThreadSafeDataBuffer;
 
 // BlobRegistryImpl is not thread-safe. It should only be called from main thread.
-class WEBCORE_EXPORT BlobRegistryImpl {
+class WEBCORE_EXPORT BlobRegistryImpl : public CanMakeWeakPtr<BlobRegistryImpl> {
     WTF_MAKE_FAST_ALLOCATED;
 public:
     virtual ~BlobRegistryImpl();
@@ -67,18 +68,39 @@ public:
 
     unsigned long long blobSize(const URL&);
 
+    static constexpr size_t defaultFileBackingThreshold = 64 * 1024 * 1024;
+
+    // Blobs holding at least this many bytes of data are written to a temporary file in the background,
+    // and read from the memory-mapped file from then on. Zero keeps all blobs in memory.
+    void setFileBackingThreshold(size_t threshold) { m_fileBackingThreshold = threshold; }
+    size_t fileBackingThreshold() const { return m_fileBackingThreshold; }
+
     void writeBlobsToTemporaryFiles(const Vector<String>& blobURLs, CompletionHandler<void(Vector<String>&& filePaths)>&&);
 
     struct BlobForFileWriting {
+        // Either a range of a data buffer or a range of a file. A file length of BlobDataItem::toEndOfFile means the whole file.
+        struct Part {
+            String filePath;
+            ThreadSafeDataBuffer data;
+            long long offset { 0 };
+            long long length { 0 };
+            // Keeps the file alive until the write is done. Only referenced and released on the main thread.
+            RefPtr<BlobDataFileReference> file;
+        };
+
         String blobURL;
-        Vector<std::pair<String, ThreadSafeDataBuffer>> filePathsOrDataBuffers;
+        Vector<Part> parts;
     };
 
     bool populateBlobsForFileWriting(const Vector<String>& blobURLs, Vector<BlobForFileWriting>&);
     Vector<RefPtr<BlobDataFileReference>> filesInBlob(const URL&) const;
 
 private:
+    void spillDataToFile(Vector<ThreadSafeDataBuffer>&&, size_t dataSize);
+    void swapInSpilledData(const Vector<ThreadSafeDataBuffer>&, Ref<BlobDataFileReference>&&);
+
     HashMap<String, RefPtr<BlobData>> m_blobs;
+    size_t m_fileBackingThreshold { defaultFileBackingThreshold };
 };
 
 } // namespace WebCore
@@ -248,6 +248,11 @@ void BlobResourceHandle::getSizeForNext()
         didGetSize(item.length());
         break;
     case BlobDataItem::Type::File:
+        // Spilled blob data lives in a temporary file nobody else writes to.
+        if (item.file()->isSpilledData()) {
+            didGetSize(item.length());
+            break;
+        }
         // Files know their sizes, but asking the stream to verify that the file wasn't modified.
         if (m_async)
             m_asyncStream->getSize(item.file()->path(), item.file()->expectedModificationTime());
@@ -320,6 +325,20 @@ void BlobResourceHandle::seek()
         m_totalRemainingSize -= m_rangeOffset;
 }
 
+// Data items, and file items holding spilled blob data, are read straight from memory. For the latter
+// that is the mapped pages of the temporary file. Returns null when the item has to go through a file stream.
+static const uint8_t* inMemoryBytes(const BlobDataItem& item)
+{
+    switch (item.type()) {
+    case BlobDataItem::Type::Data:
+        return item.data().data() ? item.data().data()->data() : nullptr;
+    case BlobDataItem::Type::File:
+        return item.file()->mappedData();
+    }
+    ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
 int BlobResourceHandle::readSync(char* buf, int length)
 {
     ASSERT(isMainThread());
@@ -340,8 +359,8 @@ int BlobResourceHandle::readSync(char* buf, int length)
 
         const BlobDataItem& item = m_blobData->items().at(m_readItemCount);
         int bytesRead = 0;
-        if (item.type() == BlobDataItem::Type::Data)
-            bytesRead = readDataSync(item, buf + offset, remaining);
+        if (auto* bytes = inMemoryBytes(item))
+            bytesRead = readDataSync(item, bytes, buf + offset, remaining);
         else if (item.type() == BlobDataItem::Type::File)
             bytesRead = readFileSync(item, buf + offset, remaining);
         else
@@ -368,7 +387,7 @@ int BlobResourceHandle::readSync(char* buf, int length)
     return result;
 }
 
-int BlobResourceHandle::readDataSync(const BlobDataItem& item, char* buf, int length)
+int BlobResourceHandle::readDataSync(const BlobDataItem& item, const uint8_t* bytes, char* buf, int length)
 {
     ASSERT(isMainThread());
 
@@ -378,7 +397,7 @@ int BlobResourceHandle::readDataSync(const BlobDataItem& item, char* buf, int le
     int bytesToRead = (length > remaining) ? static_cast<int>(remaining) : length;
     if (bytesToRead > m_totalRemainingSize)
         bytesToRead = static_cast<int>(m_totalRemainingSize);
-    memcpy(buf, item.data().data() + item.offset() + m_currentItemReadSize, bytesToRead);
+    memcpy(buf, bytes + item.offset() + m_currentItemReadSize, bytesToRead);
     m_totalRemainingSize -= bytesToRead;
 
     m_currentItemReadSize += bytesToRead;
@@ -440,18 +459,18 @@ void BlobResourceHandle::readAsync()
     }
 
     const BlobDataItem& item = m_blobData->items().at(m_readItemCount);
-    if (item.type() == BlobDataItem::Type::Data)
-        readDataAsync(item);
+    if (auto* bytes = inMemoryBytes(item))
+        readDataAsync(item, bytes);
     else if (item.type() == BlobDataItem::Type::File)
         readFileAsync(item);
     else
         ASSERT_NOT_REACHED();
 }
 
-void BlobResourceHandle::readDataAsync(const BlobDataItem& item)
+void BlobResourceHandle::readDataAsync(const BlobDataItem& item, const uint8_t* bytes)
 {
     ASSERT(isMainThread());
-    ASSERT(item.data().data());
+    ASSERT(bytes);
 
     Ref<BlobResourceHandle> protectedThis(*this);
 
@@ -460,7 +479,7 @@ void BlobResourceHandle::readDataAsync(const BlobDataItem& item)
     if (bytesToRead > m_totalRemainingSize)
         bytesToRead = m_totalRemainingSize;
 
-    auto* data = reinterpret_cast<const char*>(item.data().data()->data()) + item.offset() + m_currentItemReadSize;
+    auto* data = reinterpret_cast<const char*>(bytes) + item.offset() + m_currentItemReadSize;
     m_currentItemReadSize = 0;
 
     consumeData(data, static_cast<int>(bytesToRead));
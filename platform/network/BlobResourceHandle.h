@@ -83,10 +83,10 @@ private:
     void failed(Error);
 
     void readAsync();
-    void readDataAsync(const BlobDataItem&);
+    void readDataAsync(const BlobDataItem&, const uint8_t* bytes);
     void readFileAsync(const BlobDataItem&);
 
-    int readDataSync(const BlobDataItem&, char*, int);
+    int readDataSync(const BlobDataItem&, const uint8_t* bytes, char*, int);
     int readFileSync(const BlobDataItem&, char*, int);
 
     void notifyResponse();
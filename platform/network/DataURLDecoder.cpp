@@ -31,6 +31,8 @@
 #include "ParsedContentType.h"
 #include "SharedBuffer.h"
 #include "TextEncoding.h"
+#include <array>
+#include <wtf/ASCIICType.h>
 #include <wtf/MainThread.h>
 #include <wtf/Optional.h>
 #include <wtf/RunLoop.h>
@@ -42,6 +44,12 @@
 #include "VersionChecks.h"
 #endif
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 namespace WebCore {
 namespace DataURLDecoder {
 
@@ -62,6 +70,9 @@ static bool shouldRemoveFragmentIdentifier(const String& mediaType)
 #endif
 }
 
+// Data URLs up to this length are decoded on the calling thread rather than on the decode queue.
+static const unsigned maximumSynchronousDecodeLength = 32 * 1024;
+
 static WorkQueue& decodeQueue()
 {
     static auto& queue = WorkQueue::create("org.webkit.DataURLDecoder", WorkQueue::Type::Serial, WorkQueue::QOS::UserInitiated).leakRef();
@@ -78,8 +89,8 @@ static Result parseMediaType(const String& mediaType)
 struct DecodeTask {
     WTF_MAKE_FAST_ALLOCATED;
 public:
-    DecodeTask(const URL& url, const ScheduleContext& scheduleContext, DecodeCompletionHandler&& completionHandler)
-        : url(url.isolatedCopy())
+    DecodeTask(URL&& url, const ScheduleContext& scheduleContext, DecodeCompletionHandler&& completionHandler)
+        : url(WTFMove(url))
         , scheduleContext(scheduleContext)
         , completionHandler(WTFMove(completionHandler))
     {
@@ -143,27 +154,278 @@ public:
 static std::unique_ptr<DecodeTask> createDecodeTask(const URL& url, const ScheduleContext& scheduleContext, DecodeCompletionHandler&& completionHandler)
 {
     return makeUnique<DecodeTask>(
-        url,
+        url.isolatedCopy(),
         scheduleContext,
         WTFMove(completionHandler)
     );
 }
 
+#if CPU(X86_SSE2)
+
+static constexpr unsigned base64VectorLength = 16;
+
+// Decodes 16 base64 alphabet characters to 12 bytes. Returns false without writing anything if
+// any of them is outside the alphabet; the scalar loop then deals with it.
+static inline bool decodeBase64Vector(const LChar* source, uint8_t* destination)
+{
+    __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    // The compares are signed, so bytes above 0x7F fall outside every range.
+    auto inRange = [&](char low, char high) {
+        return _mm_and_si128(_mm_cmpgt_epi8(characters, _mm_set1_epi8(low - 1)), _mm_cmplt_epi8(characters, _mm_set1_epi8(high + 1)));
+    };
+    __m128i isUpper = inRange('A', 'Z');
+    __m128i isLower = inRange('a', 'z');
+    __m128i isDigit = inRange('0', '9');
+    __m128i isPlus = _mm_cmpeq_epi8(characters, _mm_set1_epi8('+'));
+    __m128i isSlash = _mm_cmpeq_epi8(characters, _mm_set1_epi8('/'));
+    __m128i isAlphabet = _mm_or_si128(_mm_or_si128(_mm_or_si128(isUpper, isLower), _mm_or_si128(isDigit, isPlus)), isSlash);
+    if (_mm_movemask_epi8(isAlphabet) != 0xFFFF)
+        return false;
+
+    __m128i offsets = _mm_or_si128(_mm_or_si128(_mm_and_si128(isUpper, _mm_set1_epi8(-'A')), _mm_and_si128(isLower, _mm_set1_epi8(26 - 'a'))),
+        _mm_or_si128(_mm_or_si128(_mm_and_si128(isDigit, _mm_set1_epi8(52 - '0')), _mm_and_si128(isPlus, _mm_set1_epi8(62 - '+'))), _mm_and_si128(isSlash, _mm_set1_epi8(63 - '/'))));
+    __m128i sextets = _mm_add_epi8(characters, offsets);
+
+    // Merge pairs of sextets into 12 bits, then pairs of those into the 24 bits of each group of four characters.
+    __m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(sextets, _mm_set1_epi16(0x00FF)), 6), _mm_srli_epi16(sextets, 8));
+    __m128i groups = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(pairs, _mm_set1_epi32(0xFFFF)), 12), _mm_srli_epi32(pairs, 16));
+
+    // SSE2 has no byte shuffle, so the three bytes of each group are written out one by one.
+    alignas(16) uint32_t values[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(values), groups);
+    for (auto value : values) {
+        *destination++ = value >> 16;
+        *destination++ = value >> 8;
+        *destination++ = value;
+    }
+    return true;
+}
+
+#elif HAVE(ARM_NEON_INTRINSICS)
+
+static constexpr unsigned base64VectorLength = 64;
+
+static inline uint8x16_t decodeBase64Sextets(uint8x16_t characters, uint8x16_t& isAlphabet)
+{
+    auto inRange = [&](uint8_t low, uint8_t high) {
+        return vandq_u8(vcgeq_u8(characters, vdupq_n_u8(low)), vcleq_u8(characters, vdupq_n_u8(high)));
+    };
+    uint8x16_t isUpper = inRange('A', 'Z');
+    uint8x16_t isLower = inRange('a', 'z');
+    uint8x16_t isDigit = inRange('0', '9');
+    uint8x16_t isPlus = vceqq_u8(characters, vdupq_n_u8('+'));
+    uint8x16_t isSlash = vceqq_u8(characters, vdupq_n_u8('/'));
+    isAlphabet = vandq_u8(isAlphabet, vorrq_u8(vorrq_u8(vorrq_u8(isUpper, isLower), vorrq_u8(isDigit, isPlus)), isSlash));
+
+    uint8x16_t offsets = vorrq_u8(vorrq_u8(vandq_u8(isUpper, vdupq_n_u8(static_cast<uint8_t>(-'A'))), vandq_u8(isLower, vdupq_n_u8(static_cast<uint8_t>(26 - 'a')))),
+        vorrq_u8(vorrq_u8(vandq_u8(isDigit, vdupq_n_u8(52 - '0')), vandq_u8(isPlus, vdupq_n_u8(62 - '+'))), vandq_u8(isSlash, vdupq_n_u8(63 - '/'))));
+    return vaddq_u8(characters, offsets);
+}
+
+// Decodes 64 base64 alphabet characters to 48 bytes. Returns false without writing anything if
+// any of them is outside the alphabet; the scalar loop then deals with it.
+static inline bool decodeBase64Vector(const LChar* source, uint8_t* destination)
+{
+    // De-interleaving loads put the first, second, third and fourth character of each group in their own vector.
+    uint8x16x4_t characters = vld4q_u8(source);
+    uint8x16_t isAlphabet = vdupq_n_u8(0xFF);
+    uint8x16_t a = decodeBase64Sextets(characters.val[0], isAlphabet);
+    uint8x16_t b = decodeBase64Sextets(characters.val[1], isAlphabet);
+    uint8x16_t c = decodeBase64Sextets(characters.val[2], isAlphabet);
+    uint8x16_t d = decodeBase64Sextets(characters.val[3], isAlphabet);
+    uint64x2_t notAlphabet = vreinterpretq_u64_u8(vmvnq_u8(isAlphabet));
+    if (vgetq_lane_u64(notAlphabet, 0) | vgetq_lane_u64(notAlphabet, 1))
+        return false;
+
+    uint8x16x3_t bytes;
+    bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+    bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+    vst3q_u8(destination, bytes);
+    return true;
+}
+
+#endif
+
+// Decodes base64, resolving percent-escapes as it goes, straight into SharedBuffer segments. This avoids
+// unescaping into a new string and decoding into one contiguous vector that is then shrunk.
+// Follows the rules of WTF::base64Decode() with Base64IgnoreSpacesAndNewLines and Base64DiscardVerticalTab.
+class StreamingBase64Decoder {
+public:
+    StreamingBase64Decoder(unsigned encodedLength, Mode mode)
+        : m_remainingCapacityEstimate(encodedLength / 4 * 3 + 3)
+        , m_validatePadding(mode == Mode::ForgivingBase64)
+    {
+    }
+
+    template<typename CharacterType> bool decode(const CharacterType*, unsigned length);
+    RefPtr<SharedBuffer> finish();
+
+private:
+    static constexpr size_t segmentSize = 64 * 1024;
+    static constexpr uint8_t whitespace = 0xFE;
+    static constexpr uint8_t nonAlphabet = 0xFF;
+
+    static const std::array<uint8_t, 128>& decodeTable();
+    template<typename CharacterType> static uint8_t valueFor(CharacterType character)
+    {
+        return character < 128 ? decodeTable()[character] : nonAlphabet;
+    }
+
+    void appendBytes(const uint8_t* bytes, unsigned count);
+
+    RefPtr<SharedBuffer> m_buffer { SharedBuffer::create() };
+    Vector<char> m_segment;
+    size_t m_remainingCapacityEstimate;
+    std::array<uint8_t, 4> m_quad;
+    unsigned m_quadSize { 0 };
+    size_t m_sextetCount { 0 };
+    unsigned m_paddingCount { 0 };
+    bool m_validatePadding;
+};
+
+const std::array<uint8_t, 128>& StreamingBase64Decoder::decodeTable()
+{
+    static const auto table = [] {
+        std::array<uint8_t, 128> table;
+        table.fill(nonAlphabet);
+        const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (uint8_t i = 0; i < 64; ++i)
+            table[static_cast<uint8_t>(alphabet[i])] = i;
+        for (char space : { ' ', '\t', '\n', '\v', '\f', '\r' })
+            table[static_cast<uint8_t>(space)] = whitespace;
+        return table;
+    }();
+    return table;
+}
+
+void StreamingBase64Decoder::appendBytes(const uint8_t* bytes, unsigned count)
+{
+    while (count) {
+        if (m_segment.size() == m_segment.capacity()) {
+            if (!m_segment.isEmpty())
+                m_buffer->append(WTFMove(m_segment));
+            m_segment.reserveInitialCapacity(std::max<size_t>(std::min(segmentSize, m_remainingCapacityEstimate), count));
+        }
+        unsigned chunkSize = std::min<size_t>(count, m_segment.capacity() - m_segment.size());
+        m_segment.append(reinterpret_cast<const char*>(bytes), chunkSize);
+        m_remainingCapacityEstimate -= std::min<size_t>(chunkSize, m_remainingCapacityEstimate);
+        bytes += chunkSize;
+        count -= chunkSize;
+    }
+}
+
+template<typename CharacterType>
+bool StreamingBase64Decoder::decode(const CharacterType* characters, unsigned length)
+{
+    for (unsigned i = 0; i < length; ++i) {
+#if CPU(X86_SSE2) || HAVE(ARM_NEON_INTRINSICS)
+        if constexpr (std::is_same<CharacterType, LChar>::value) {
+            if (!m_quadSize && !m_paddingCount && length - i >= base64VectorLength) {
+                uint8_t bytes[base64VectorLength / 4 * 3];
+                if (decodeBase64Vector(characters + i, bytes)) {
+                    appendBytes(bytes, sizeof(bytes));
+                    m_sextetCount += base64VectorLength;
+                    i += base64VectorLength - 1;
+                    continue;
+                }
+            }
+        }
+#endif
+
+        // Runs of four alphabet characters, by far the common case, decode straight to three bytes.
+        if (!m_quadSize && !m_paddingCount && length - i >= 4) {
+            uint8_t a = valueFor(characters[i]);
+            uint8_t b = valueFor(characters[i + 1]);
+            uint8_t c = valueFor(characters[i + 2]);
+            uint8_t d = valueFor(characters[i + 3]);
+            if ((a | b | c | d) < 64) {
+                uint8_t bytes[3] = { static_cast<uint8_t>(a << 2 | b >> 4), static_cast<uint8_t>(b << 4 | c >> 2), static_cast<uint8_t>(c << 6 | d) };
+                appendBytes(bytes, 3);
+                m_sextetCount += 4;
+                i += 3;
+                continue;
+            }
+        }
+
+        UChar character = characters[i];
+        if (character == '%') {
+            if (length - i < 3 || !isASCIIHexDigit(characters[i + 1]) || !isASCIIHexDigit(characters[i + 2]))
+                return false;
+            character = toASCIIHexValue(characters[i + 1], characters[i + 2]);
+            i += 2;
+        }
+
+        if (character == '=') {
+            // There should never be more than 2 padding characters.
+            if (++m_paddingCount > 2 && m_validatePadding)
+                return false;
+            continue;
+        }
+
+        uint8_t value = valueFor(character);
+        if (value == whitespace)
+            continue;
+        if (value == nonAlphabet || m_paddingCount)
+            return false;
+
+        m_quad[m_quadSize++] = value;
+        ++m_sextetCount;
+        if (m_quadSize == 4) {
+            uint8_t bytes[3] = { static_cast<uint8_t>(m_quad[0] << 2 | m_quad[1] >> 4), static_cast<uint8_t>(m_quad[1] << 4 | m_quad[2] >> 2), static_cast<uint8_t>(m_quad[2] << 6 | m_quad[3]) };
+            appendBytes(bytes, 3);
+            m_quadSize = 0;
+        }
+    }
+    return true;
+}
+
+RefPtr<SharedBuffer> StreamingBase64Decoder::finish()
+{
+    if (!m_sextetCount)
+        return m_paddingCount ? nullptr : m_buffer;
+
+    // There should be no padding if the length is a multiple of 4.
+    if (m_validatePadding && m_paddingCount && (m_sextetCount + m_paddingCount) % 4)
+        return nullptr;
+
+    // Valid data is (n * 4 + [0,2,3]) characters long.
+    if (m_quadSize == 1)
+        return nullptr;
+
+    if (m_quadSize) {
+        uint8_t bytes[2] = { static_cast<uint8_t>(m_quad[0] << 2 | m_quad[1] >> 4), static_cast<uint8_t>(m_quad[1] << 4 | m_quad[2] >> 2) };
+        appendBytes(bytes, m_quadSize - 1);
+    }
+
+    if (!m_segment.isEmpty())
+        m_buffer->append(WTFMove(m_segment));
+    return m_buffer;
+}
+
+static bool decodeBase64Streaming(DecodeTask& task, Mode mode)
+{
+    auto& encodedData = task.encodedData;
+    StreamingBase64Decoder decoder(encodedData.length(), mode);
+    bool success = encodedData.is8Bit() ? decoder.decode(encodedData.characters8(), encodedData.length()) : decoder.decode(encodedData.characters16(), encodedData.length());
+    if (!success)
+        return false;
+    task.result.data = decoder.finish();
+    return !!task.result.data;
+}
+
 static void decodeBase64(DecodeTask& task, Mode mode)
 {
+    // Legacy mode also accepts the base64url alphabet, which the streaming decoder does not handle.
+    if (decodeBase64Streaming(task, mode) || mode == Mode::ForgivingBase64)
+        return;
+
     Vector<char> buffer;
-    if (mode == Mode::ForgivingBase64) {
+    if (!base64URLDecode(task.encodedData.toStringWithoutCopying(), buffer)) {
+        // Didn't work, try unescaping and decoding as base64.
         auto unescapedString = decodeURLEscapeSequences(task.encodedData.toStringWithoutCopying());
-        if (!base64Decode(unescapedString, buffer, Base64ValidatePadding | Base64IgnoreSpacesAndNewLines | Base64DiscardVerticalTab))
+        if (!base64Decode(unescapedString, buffer, Base64IgnoreSpacesAndNewLines | Base64DiscardVerticalTab))
             return;
-    } else {
-        // First try base64url.
-        if (!base64URLDecode(task.encodedData.toStringWithoutCopying(), buffer)) {
-            // Didn't work, try unescaping and decoding as base64.
-            auto unescapedString = decodeURLEscapeSequences(task.encodedData.toStringWithoutCopying());
-            if (!base64Decode(unescapedString, buffer, Base64IgnoreSpacesAndNewLines | Base64DiscardVerticalTab))
-                return;
-        }
     }
     buffer.shrinkToFit();
     task.result.data = SharedBuffer::create(WTFMove(buffer));
@@ -174,22 +436,51 @@ static void decodeEscaped(DecodeTask& task)
     TextEncoding encodingFromCharset(task.result.charset);
     auto& encoding = encodingFromCharset.isValid() ? encodingFromCharset : UTF8Encoding();
     auto buffer = decodeURLEscapeSequencesAsData(task.encodedData, encoding);
-
-    buffer.shrinkToFit();
     task.result.data = SharedBuffer::create(WTFMove(buffer));
 }
 
+static void runDecodeTask(DecodeTask& task, Mode mode)
+{
+    if (!task.process())
+        return;
+    if (task.isBase64)
+        decodeBase64(task, mode);
+    else
+        decodeEscaped(task);
+}
+
+Optional<Result> decode(const URL& url, Mode mode)
+{
+    ASSERT(url.protocolIsData());
+
+    DecodeTask task { URL { url }, { }, { } };
+    runDecodeTask(task, mode);
+    if (!task.result.data)
+        return WTF::nullopt;
+    return WTFMove(task.result);
+}
+
 void decode(const URL& url, const ScheduleContext& scheduleContext, Mode mode, DecodeCompletionHandler&& completionHandler)
 {
     ASSERT(url.protocolIsData());
 
+    // Small payloads are not worth a trip to the decode queue. The completion handler is still
+    // called from the run loop so the caller sees the same asynchronous behavior.
+    if (url.string().length() <= maximumSynchronousDecodeLength) {
+        auto callCompletionHandler = [completionHandler = WTFMove(completionHandler), result = decode(url, mode)]() mutable {
+            completionHandler(WTFMove(result));
+        };
+#if USE(COCOA_EVENT_LOOP)
+        RunLoop::dispatch(scheduleContext.scheduledPairs, WTFMove(callCompletionHandler));
+#else
+        UNUSED_PARAM(scheduleContext);
+        RunLoop::main().dispatch(WTFMove(callCompletionHandler));
+#endif
+        return;
+    }
+
     decodeQueue().dispatch([decodeTask = createDecodeTask(url, scheduleContext, WTFMove(completionHandler)), mode]() mutable {
-        if (decodeTask->process()) {
-            if (decodeTask->isBase64)
-                decodeBase64(*decodeTask, mode);
-            else
-                decodeEscaped(*decodeTask);
-        }
+        runDecodeTask(*decodeTask, mode);
 
 #if USE(COCOA_EVENT_LOOP)
         auto scheduledPairs = decodeTask->scheduleContext.scheduledPairs;
@@ -53,6 +53,7 @@ struct ScheduleContext {
 
 enum class Mode { Legacy, ForgivingBase64 };
 void decode(const URL&, const ScheduleContext&, Mode, DecodeCompletionHandler&&);
+Optional<Result> decode(const URL&, Mode);
 
 }
 
@@ -46,9 +46,34 @@ HTTPHeaderMap HTTPHeaderMap::isolatedCopy() const
     HTTPHeaderMap map;
     map.m_commonHeaders = crossThreadCopy(m_commonHeaders);
     map.m_uncommonHeaders = crossThreadCopy(m_uncommonHeaders);
+    map.m_commonHeaderPositions = m_commonHeaderPositions;
     return map;
 }
 
+void HTTPHeaderMap::appendCommonHeader(HTTPHeaderName name, const String& value)
+{
+    ASSERT(!contains(name));
+    m_commonHeaders.append(CommonHeader { name, value });
+    m_commonHeaderPositions[static_cast<unsigned>(name)] = m_commonHeaders.size();
+}
+
+void HTTPHeaderMap::rebuildCommonHeaderPositions()
+{
+    ASSERT(m_commonHeaders.size() <= numHTTPHeaderNames);
+    m_commonHeaderPositions.fill(0);
+    for (size_t i = 0; i < m_commonHeaders.size(); ++i) {
+        auto& position = m_commonHeaderPositions[static_cast<unsigned>(m_commonHeaders[i].key)];
+        if (!position)
+            position = i + 1;
+    }
+}
+
+auto HTTPHeaderMap::takeCommonHeaders() -> CommonHeadersVector
+{
+    m_commonHeaderPositions.fill(0);
+    return std::exchange(m_commonHeaders, { });
+}
+
 String HTTPHeaderMap::get(const String& name) const
 {
     HTTPHeaderName headerName;
@@ -131,7 +156,7 @@ void HTTPHeaderMap::append(const String& name, const String& value)
 
     HTTPHeaderName headerName;
     if (findHTTPHeaderName(name, headerName))
-        m_commonHeaders.append(CommonHeader { headerName, value });
+        appendCommonHeader(headerName, value);
     else
         m_uncommonHeaders.append(UncommonHeader { name, value });
 }
@@ -141,7 +166,7 @@ bool HTTPHeaderMap::addIfNotPresent(HTTPHeaderName headerName, const String& val
     if (contains(headerName))
         return false;
 
-    m_commonHeaders.append(CommonHeader { headerName, value });
+    appendCommonHeader(headerName, value);
     return true;
 }
 
@@ -169,46 +194,42 @@ bool HTTPHeaderMap::remove(const String& name)
 
 String HTTPHeaderMap::get(HTTPHeaderName name) const
 {
-    auto index = m_commonHeaders.findMatching([&](auto& header) {
-        return header.key == name;
-    });
-    return index != notFound ? m_commonHeaders[index].value : String();
+    auto position = commonHeaderPosition(name);
+    return position ? m_commonHeaders[*position].value : String();
 }
 
 void HTTPHeaderMap::set(HTTPHeaderName name, const String& value)
 {
-    auto index = m_commonHeaders.findMatching([&](auto& header) {
-        return header.key == name;
-    });
-    if (index == notFound)
-        m_commonHeaders.append(CommonHeader { name, value });
+    if (auto position = commonHeaderPosition(name))
+        m_commonHeaders[*position].value = value;
     else
-        m_commonHeaders[index].value = value;
+        appendCommonHeader(name, value);
 }
 
 bool HTTPHeaderMap::contains(HTTPHeaderName name) const
 {
-    return m_commonHeaders.findMatching([&](auto& header) {
-        return header.key == name;
-    }) != notFound;
+    return !!commonHeaderPosition(name);
 }
 
 bool HTTPHeaderMap::remove(HTTPHeaderName name)
 {
-    return m_commonHeaders.removeFirstMatching([&](auto& header) {
-        return header.key == name;
-    });
+    auto position = commonHeaderPosition(name);
+    if (!position)
+        return false;
+
+    m_commonHeaders.remove(*position);
+    m_commonHeaderPositions[static_cast<unsigned>(name)] = 0;
+    for (size_t i = *position; i < m_commonHeaders.size(); ++i)
+        --m_commonHeaderPositions[static_cast<unsigned>(m_commonHeaders[i].key)];
+    return true;
 }
 
 void HTTPHeaderMap::add(HTTPHeaderName name, const String& value)
 {
-    auto index = m_commonHeaders.findMatching([&](auto& header) {
-        return header.key == name;
-    });
-    if (index != notFound)
-        m_commonHeaders[index].value = makeString(m_commonHeaders[index].value, ", ", value);
+    if (auto position = commonHeaderPosition(name))
+        m_commonHeaders[*position].value = makeString(m_commonHeaders[*position].value, ", ", value);
     else
-        m_commonHeaders.append(CommonHeader { name, value });
+        appendCommonHeader(name, value);
 }
 
 } // namespace WebCore
@@ -27,6 +27,8 @@
 #pragma once
 
 #include "HTTPHeaderNames.h"
+#include <array>
+#include <limits>
 #include <utility>
 #include <wtf/HashMap.h>
 #include <wtf/Optional.h>
@@ -145,6 +147,7 @@ public:
     {
         m_commonHeaders.clear();
         m_uncommonHeaders.clear();
+        m_commonHeaderPositions.fill(0);
     }
 
     void shrinkToFit()
@@ -182,9 +185,12 @@ public:
 
     const CommonHeadersVector& commonHeaders() const { return m_commonHeaders; }
     const UncommonHeadersVector& uncommonHeaders() const { return m_uncommonHeaders; }
-    CommonHeadersVector& commonHeaders() { return m_commonHeaders; }
     UncommonHeadersVector& uncommonHeaders() { return m_uncommonHeaders; }
 
+    // Common headers are indexed by name, so they can only be changed through these.
+    WEBCORE_EXPORT CommonHeadersVector takeCommonHeaders();
+    template<typename MatchFunction> void removeAllCommonHeadersMatching(const MatchFunction&);
+
     const_iterator begin() const { return const_iterator(*this, m_commonHeaders.begin(), m_uncommonHeaders.begin()); }
     const_iterator end() const { return const_iterator(*this, m_commonHeaders.end(), m_uncommonHeaders.end()); }
 
@@ -215,10 +221,31 @@ private:
     void setUncommonHeader(const String& name, const String& value);
     WEBCORE_EXPORT String getUncommonHeader(const String& name) const;
 
+    Optional<size_t> commonHeaderPosition(HTTPHeaderName name) const
+    {
+        if (auto position = m_commonHeaderPositions[static_cast<unsigned>(name)])
+            return position - 1;
+        return WTF::nullopt;
+    }
+    void appendCommonHeader(HTTPHeaderName, const String& value);
+    WEBCORE_EXPORT void rebuildCommonHeaderPositions();
+
     CommonHeadersVector m_commonHeaders;
     UncommonHeadersVector m_uncommonHeaders;
+
+    // Position + 1 in m_commonHeaders of each header name, or 0 when the header is not present.
+    // HTTPHeaderName values are dense, so this is a collision-free index for constant time lookups.
+    static_assert(numHTTPHeaderNames < std::numeric_limits<uint8_t>::max(), "Header positions must fit in a uint8_t");
+    std::array<uint8_t, numHTTPHeaderNames> m_commonHeaderPositions { };
 };
 
+template<typename MatchFunction>
+void HTTPHeaderMap::removeAllCommonHeadersMatching(const MatchFunction& matches)
+{
+    if (m_commonHeaders.removeAllMatching(matches))
+        rebuildCommonHeaderPositions();
+}
+
 template <class Encoder>
 void HTTPHeaderMap::CommonHeader::encode(Encoder& encoder) const
 {
@@ -275,6 +302,9 @@ bool HTTPHeaderMap::decode(Decoder& decoder, HTTPHeaderMap& headerMap)
     if (!decoder.decode(headerMap.m_uncommonHeaders))
         return false;
 
+    if (headerMap.m_commonHeaders.size() > numHTTPHeaderNames)
+        return false;
+    headerMap.rebuildCommonHeaderPositions();
     return true;
 }
 
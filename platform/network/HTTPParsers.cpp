@@ -36,11 +36,18 @@
 #include "HTTPHeaderField.h"
 #include "HTTPHeaderNames.h"
 #include "ParsedContentType.h"
+#include <array>
 #include <wtf/DateMath.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/Optional.h>
 #include <wtf/unicode/CharacterNames.h>
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 namespace WebCore {
 
 // True if characters which satisfy the predicate are present, incrementing
@@ -640,28 +647,57 @@ static inline bool isValidHeaderNameCharacter(const char* character)
     // https://tools.ietf.org/html/rfc7230#section-3.2
     // A header name should only contain one or more of
     // alphanumeric or ! # $ % & ' * + - . ^ _ ` | ~
-    if (isASCIIAlphanumeric(*character))
-        return true;
-    switch (*character) {
-    case '!':
-    case '#':
-    case '$':
-    case '%':
-    case '&':
-    case '\'':
-    case '*':
-    case '+':
-    case '-':
-    case '.':
-    case '^':
-    case '_':
-    case '`':
-    case '|':
-    case '~':
-        return true;
-    default:
-        return false;
+    static const auto table = [] {
+        std::array<bool, 256> table { };
+        for (unsigned c = 0; c < 128; ++c)
+            table[c] = isASCIIAlphanumeric(c);
+        for (char c : { '!', '#', '$', '%', '&', '\'', '*', '+', '-', '.', '^', '_', '`', '|', '~' })
+            table[static_cast<uint8_t>(c)] = true;
+        return table;
+    }();
+    return table[static_cast<uint8_t>(*character)];
+}
+
+// Returns the first CR or LF in [p, end), or end. Header values are scanned 16 bytes at a time where
+// SSE2 or NEON is available, then a machine word at a time; the byte loop only pins down the terminator.
+static const char* findLineTerminator(const char* p, const char* end)
+{
+#if CPU(X86_SSE2)
+    const __m128i carriageReturns = _mm_set1_epi8('\r');
+    const __m128i lineFeeds = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, carriageReturns), _mm_cmpeq_epi8(bytes, lineFeeds))))
+            break;
+    }
+#elif HAVE(ARM_NEON_INTRINSICS)
+    const uint8x16_t carriageReturns = vdupq_n_u8('\r');
+    const uint8x16_t lineFeeds = vdupq_n_u8('\n');
+    for (; end - p >= 16; p += 16) {
+        uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        uint64x2_t matches = vreinterpretq_u64_u8(vorrq_u8(vceqq_u8(bytes, carriageReturns), vceqq_u8(bytes, lineFeeds)));
+        if (vgetq_lane_u64(matches, 0) | vgetq_lane_u64(matches, 1))
+            break;
+    }
+#endif
+
+    constexpr uint64_t lowBits = 0x0101010101010101ULL;
+    constexpr uint64_t highBits = 0x8080808080808080ULL;
+    auto hasZeroByte = [&](uint64_t word) {
+        return (word - lowBits) & ~word & highBits;
+    };
+
+    for (; end - p >= 8; p += 8) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        if (hasZeroByte(word ^ (lowBits * '\r')) || hasZeroByte(word ^ (lowBits * '\n')))
+            break;
+    }
+    for (; p < end; ++p) {
+        if (*p == '\r' || *p == '\n')
+            return p;
     }
+    return end;
 }
 
 size_t parseHTTPHeader(const char* start, size_t length, String& failureReason, StringView& nameStr, String& valueStr, bool strict)
@@ -669,81 +705,59 @@ size_t parseHTTPHeader(const char* start, size_t length, String& failureReason,
     const char* p = start;
     const char* end = start + length;
 
-    Vector<char> name;
-    Vector<char> value;
-
-    bool foundFirstNameChar = false;
-    const char* namePtr = nullptr;
-    size_t nameSize = 0;
-
     nameStr = StringView();
     valueStr = String();
 
-    for (; p < end; p++) {
+    const char* nameStart = p;
+    while (p < end && isValidHeaderNameCharacter(p))
+        ++p;
+    size_t nameSize = p - nameStart;
+
+    if (p < end) {
         switch (*p) {
         case '\r':
-            if (name.isEmpty()) {
+            if (!nameSize) {
                 if (p + 1 < end && *(p + 1) == '\n')
                     return (p + 2) - start;
                 failureReason = makeString("CR doesn't follow LF in header name at ", trimInputSample(p, end - p));
                 return 0;
             }
-            failureReason = makeString("Unexpected CR in header name at ", trimInputSample(name.data(), name.size()));
+            failureReason = makeString("Unexpected CR in header name at ", trimInputSample(nameStart, nameSize));
             return 0;
         case '\n':
-            failureReason = makeString("Unexpected LF in header name at ", trimInputSample(name.data(), name.size()));
+            failureReason = makeString("Unexpected LF in header name at ", trimInputSample(nameStart, nameSize));
             return 0;
         case ':':
-            break;
-        default:
-            if (!isValidHeaderNameCharacter(p)) {
-                if (name.size() < 1)
-                    failureReason = "Unexpected start character in header name";
-                else
-                    failureReason = makeString("Unexpected character in header name at ", trimInputSample(name.data(), name.size()));
-                return 0;
-            }
-            name.append(*p);
-            if (!foundFirstNameChar) {
-                namePtr = p;
-                foundFirstNameChar = true;
-            }
-            continue;
-        }
-        if (*p == ':') {
             ++p;
             break;
+        default:
+            if (!nameSize)
+                failureReason = "Unexpected start character in header name";
+            else
+                failureReason = makeString("Unexpected character in header name at ", trimInputSample(nameStart, nameSize));
+            return 0;
         }
     }
 
-    nameSize = name.size();
-    nameStr = StringView(namePtr, nameSize);
+    nameStr = StringView(nameStart, nameSize);
 
     for (; p < end && *p == 0x20; p++) { }
 
-    for (; p < end; p++) {
-        switch (*p) {
-        case '\r':
-            break;
-        case '\n':
-            if (strict) {
-                failureReason = makeString("Unexpected LF in header value at ", trimInputSample(value.data(), value.size()));
-                return 0;
-            }
-            break;
-        default:
-            value.append(*p);
-        }
-        if (*p == '\r' || (!strict && *p == '\n')) {
-            ++p;
-            break;
+    const char* valueStart = p;
+    p = findLineTerminator(p, end);
+    size_t valueSize = p - valueStart;
+    if (p < end) {
+        if (strict && *p == '\n') {
+            failureReason = makeString("Unexpected LF in header value at ", trimInputSample(valueStart, valueSize));
+            return 0;
         }
+        ++p;
     }
     if (p >= end || (strict && *p != '\n')) {
         failureReason = makeString("CR doesn't follow LF after header value at ", trimInputSample(p, end - p));
         return 0;
     }
-    valueStr = String::fromUTF8(value.data(), value.size());
+    valueStr = String::fromUTF8(valueStart, valueSize);
     if (valueStr.isNull()) {
         failureReason = "Invalid UTF-8 sequence in header value"_s;
         return 0;
@@ -187,7 +187,7 @@ ResourceResponse ResourceResponseBase::filter(const ResourceResponse& response,
     filteredResponse.m_httpHeaderFields.uncommonHeaders().removeAllMatching([&](auto& entry) {
         return !isCrossOriginSafeHeader(entry.key, accessControlExposeHeaderSet);
     });
-    filteredResponse.m_httpHeaderFields.commonHeaders().removeAllMatching([&](auto& entry) {
+    filteredResponse.m_httpHeaderFields.removeAllCommonHeadersMatching([&](auto& entry) {
         return !isCrossOriginSafeHeader(entry.key, accessControlExposeHeaderSet);
     });
 
@@ -450,7 +450,7 @@ void ResourceResponseBase::sanitizeHTTPHeaderFieldsAccordingToTainting()
         HTTPHeaderMap filteredHeaders;
         for (auto& header : m_httpHeaderFields.commonHeaders()) {
             if (isSafeCrossOriginResponseHeader(header.key))
-                filteredHeaders.add(header.key, WTFMove(header.value));
+                filteredHeaders.add(header.key, header.value);
         }
         for (auto& headerName : corsSafeHeaderSet) {
             if (!filteredHeaders.contains(headerName)) {
@@ -467,7 +467,7 @@ void ResourceResponseBase::sanitizeHTTPHeaderFieldsAccordingToTainting()
         HTTPHeaderMap filteredHeaders;
         for (auto& header : m_httpHeaderFields.commonHeaders()) {
             if (isSafeCrossOriginResponseHeader(header.key))
-                filteredHeaders.add(header.key, WTFMove(header.value));
+                filteredHeaders.add(header.key, header.value);
         }
         m_httpHeaderFields = WTFMove(filteredHeaders);
         return;
@@ -486,7 +486,7 @@ void ResourceResponseBase::sanitizeHTTPHeaderFields(SanitizationType type)
     case SanitizationType::RemoveCookies:
         return;
     case SanitizationType::Redirection: {
-        auto commonHeaders = WTFMove(m_httpHeaderFields.commonHeaders());
+        auto commonHeaders = m_httpHeaderFields.takeCommonHeaders();
         for (auto& header : commonHeaders) {
             if (isSafeRedirectionResponseHeader(header.key))
                 m_httpHeaderFields.add(header.key, WTFMove(header.value));
@@ -230,6 +230,12 @@ public:
 
     void createBidiRunsForLine(const Iterator& end, VisualDirectionOverride = NoVisualOverride, bool hardLineBreak = false);
 
+    // Fast path for the common case of left-to-right text in a left-to-right paragraph. When the caller knows
+    // the line has no right-to-left characters, Arabic numbers, bidi control characters or embeddings, every
+    // character resolves to the paragraph level, so the line becomes a single run without classifying each one.
+    bool canCreateLeftToRightRunsForLine() const;
+    void createLeftToRightRunsForLine(const Iterator& end);
+
     BidiRunList<Run>& runs() { return m_runs; }
 
     // FIXME: This used to be part of deleteRuns() but was a layering violation.
@@ -958,6 +964,30 @@ void BidiResolverBase<Iterator, Run, DerivedClass>::createBidiRunsForLine(const
     endOfLine = Iterator();
 }
 
+template<typename Iterator, typename Run, typename DerivedClass>
+bool BidiResolverBase<Iterator, Run, DerivedClass>::canCreateLeftToRightRunsForLine() const
+{
+    auto* context = this->context();
+    if (!context || context->parent() || context->dir() != U_LEFT_TO_RIGHT || context->override())
+        return false;
+    if (inIsolate() || !m_currentExplicitEmbeddingSequence.isEmpty())
+        return false;
+    // European numbers only resolve to the paragraph level after a left-to-right strong character.
+    return m_status.lastStrong == U_LEFT_TO_RIGHT && (m_status.eor == U_LEFT_TO_RIGHT || m_status.eor == U_EUROPEAN_NUMBER);
+}
+
+template<typename Iterator, typename Run, typename DerivedClass>
+void BidiResolverBase<Iterator, Run, DerivedClass>::createLeftToRightRunsForLine(const Iterator& end)
+{
+    ASSERT(canCreateLeftToRightRunsForLine());
+
+    // Without right-to-left characters the last strong direction stays left-to-right. Keep the status
+    // the line started with rather than the one appendRun() leaves behind.
+    auto status = m_status;
+    createBidiRunsForLine(end, VisualLeftToRightOverride);
+    m_status = status;
+}
+
 template<typename Iterator, typename Run, typename DerivedClass>
 void BidiResolverBase<Iterator, Run, DerivedClass>::setWhitespaceCollapsingTransitionForIsolatedRun(Run& run, size_t transition)
 {
@@ -4928,7 +4928,7 @@ const std::array<std::pair<uint16_t, UChar32>, 18590>& big5()
 }
 
 // From https://encoding.spec.whatwg.org/index-euc-kr.txt
-const std::array<std::pair<uint16_t, UChar>, 17048> eucKRDecodingIndex {{
+constexpr std::array<std::pair<uint16_t, UChar>, 17048> eucKRDecodingIndex {{
     { 0, 0xAC02 }, { 1, 0xAC03 }, { 2, 0xAC05 }, { 3, 0xAC06 }, { 4, 0xAC0B }, { 5, 0xAC0C }, { 6, 0xAC0D }, { 7, 0xAC0E },
     { 8, 0xAC0F }, { 9, 0xAC18 }, { 10, 0xAC1E }, { 11, 0xAC1F }, { 12, 0xAC21 }, { 13, 0xAC22 }, { 14, 0xAC23 }, { 15, 0xAC25 },
     { 16, 0xAC26 }, { 17, 0xAC27 }, { 18, 0xAC28 }, { 19, 0xAC29 }, { 20, 0xAC2A }, { 21, 0xAC2B }, { 22, 0xAC2E }, { 23, 0xAC32 },
@@ -7067,6 +7067,79 @@ const std::array<std::pair<uint16_t, UChar>, 17048>& eucKR()
     return eucKRDecodingIndex;
 }
 
+// Unlike the other indexes, index-euc-kr is already compiled in, so the direct lookup tables below are derived from it
+// at compile time. They live in read-only data instead of being built on the heap of every process that uses EUC-KR.
+constexpr size_t eucKRPointerCount = eucKRDecodingIndex.back().first + 1;
+constexpr auto eucKRCodePointTable = [] {
+    std::array<UChar, eucKRPointerCount> table { };
+    for (auto& pair : eucKRDecodingIndex)
+        table[pair.first] = pair.second;
+    return table;
+}();
+
+Optional<UChar> eucKRCodePoint(uint16_t pointer)
+{
+    if (pointer >= eucKRCodePointTable.size())
+        return WTF::nullopt;
+    if (UChar codePoint = eucKRCodePointTable[pointer])
+        return codePoint;
+    return WTF::nullopt;
+}
+
+// The reverse map is two-level: the high bits of a code point select a block of pointers, and only blocks
+// that contain at least one mapped code point are stored.
+constexpr unsigned eucKRPointerBlockShift = 6;
+constexpr UChar eucKRPointerBlockMask = (1 << eucKRPointerBlockShift) - 1;
+constexpr size_t eucKRPointerBlockIndexSize = 0x10000 >> eucKRPointerBlockShift;
+constexpr uint16_t noEUCKRPointer = 0xFFFF;
+static_assert(eucKRPointerCount < noEUCKRPointer);
+
+constexpr size_t eucKRPointerBlockCount = [] {
+    std::array<bool, eucKRPointerBlockIndexSize> usedBlocks { };
+    for (auto& pair : eucKRDecodingIndex)
+        usedBlocks[pair.second >> eucKRPointerBlockShift] = true;
+    size_t count = 0;
+    for (bool used : usedBlocks)
+        count += used;
+    return count;
+}();
+
+struct EUCKRPointerTable {
+    // Zero means no block, otherwise the index of the block plus one.
+    std::array<uint16_t, eucKRPointerBlockIndexSize> blockIndex;
+    std::array<std::array<uint16_t, eucKRPointerBlockMask + 1>, eucKRPointerBlockCount> blocks;
+};
+
+constexpr auto eucKRPointerTable = [] {
+    EUCKRPointerTable table { };
+    for (auto& block : table.blocks) {
+        for (auto& pointer : block)
+            pointer = noEUCKRPointer;
+    }
+    uint16_t blockCount = 0;
+    for (auto& pair : eucKRDecodingIndex) {
+        auto& blockNumber = table.blockIndex[pair.second >> eucKRPointerBlockShift];
+        if (!blockNumber)
+            blockNumber = ++blockCount;
+        // index-euc-kr has no duplicate code points, so there is no need to keep the first pointer explicitly.
+        table.blocks[blockNumber - 1][pair.second & eucKRPointerBlockMask] = pair.first;
+    }
+    return table;
+}();
+
+Optional<uint16_t> eucKRPointer(UChar32 codePoint)
+{
+    if (codePoint < 0 || codePoint > 0xFFFF)
+        return WTF::nullopt;
+    auto blockNumber = eucKRPointerTable.blockIndex[codePoint >> eucKRPointerBlockShift];
+    if (!blockNumber)
+        return WTF::nullopt;
+    auto pointer = eucKRPointerTable.blocks[blockNumber - 1][codePoint & eucKRPointerBlockMask];
+    if (pointer == noEUCKRPointer)
+        return WTF::nullopt;
+    return pointer;
+}
+
 #if ASSERT_ENABLED
 // From https://encoding.spec.whatwg.org/index-gb18030.txt
 const std::array<UChar, 23940> gb18030Reference {{
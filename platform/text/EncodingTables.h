@@ -40,6 +40,10 @@ const std::array<std::pair<uint16_t, UChar32>, 18590>& big5();
 const std::array<std::pair<uint16_t, UChar>, 17048>& eucKR();
 const std::array<UChar, 23940>& gb18030();
 
+// Direct lookups into index-euc-kr, in both directions.
+Optional<UChar> eucKRCodePoint(uint16_t pointer);
+Optional<uint16_t> eucKRPointer(UChar32 codePoint);
+
 void checkEncodingTableInvariants();
 
 // Functions for using sorted arrays of pairs as a map.
@@ -178,7 +178,8 @@ static const JIS0208EncodeIndex& jis0208EncodeIndex()
     return *table;
 }
 
-String TextCodecCJK::decodeCommon(const uint8_t* bytes, size_t length, bool flush, bool stopOnError, bool& sawError, const Function<SawError(uint8_t, StringBuilder&)>& byteParser)
+template<typename ByteParser>
+String TextCodecCJK::decodeCommon(const uint8_t* bytes, size_t length, bool flush, bool stopOnError, bool& sawError, const ByteParser& byteParser)
 {
     StringBuilder result;
     result.reserveCapacity(length);
@@ -192,6 +193,16 @@ String TextCodecCJK::decodeCommon(const uint8_t* bytes, size_t length, bool flus
         }
     }
     for (size_t i = 0; i < length; i++) {
+        // Outside of a multi-byte sequence, ASCII bytes decode to themselves in all the encodings using this,
+        // so append whole runs of them instead of going through the byte parser one at a time.
+        if (!m_lead && !m_gb18030First && isASCII(bytes[i])) {
+            size_t runEnd = i + 1;
+            while (runEnd < length && isASCII(bytes[runEnd]))
+                ++runEnd;
+            result.append(bytes + i, runEnd - i);
+            i = runEnd - 1;
+            continue;
+        }
         if (byteParser(bytes[i], result) == SawError::Yes) {
             sawError = true;
             result.append(replacementCharacter);
@@ -444,6 +455,23 @@ String TextCodecCJK::iso2022JPDecode(const uint8_t* bytes, size_t length, bool f
         }
     }
     for (size_t i = 0; i < length; i++) {
+        // In the ASCII and Roman states, every byte other than the shift and escape bytes (and the two bytes
+        // Roman remaps) decodes to itself, so append whole runs of them instead of going through the byte parser.
+        if (m_iso2022JPDecoderState == ISO2022JPDecoderState::ASCII || m_iso2022JPDecoderState == ISO2022JPDecoderState::Roman) {
+            bool isRoman = m_iso2022JPDecoderState == ISO2022JPDecoderState::Roman;
+            auto decodesToItself = [isRoman] (uint8_t byte) {
+                return byte <= 0x7F && byte != 0x0E && byte != 0x0F && byte != 0x1B && !(isRoman && (byte == 0x5C || byte == 0x7E));
+            };
+            size_t runEnd = i;
+            while (runEnd < length && decodesToItself(bytes[runEnd]))
+                ++runEnd;
+            if (runEnd > i) {
+                m_iso2022JPOutput = false;
+                result.append(bytes + i, runEnd - i);
+                i = runEnd - 1;
+                continue;
+            }
+        }
         if (byteParser(bytes[i], result) == SawError::Yes) {
             sawError = true;
             result.append(replacementCharacter);
@@ -688,23 +716,6 @@ static Vector<uint8_t> shiftJISEncode(StringView string, Function<void(UChar32,
     return result;
 }
 
-using EUCKREncodingIndex = std::array<std::pair<UChar, uint16_t>, sizeof(eucKR()) / sizeof(eucKR()[0])>;
-static const EUCKREncodingIndex& eucKREncodingIndex()
-{
-    // Allocate this at runtime because building it at compile time would make the binary much larger and this is often not used.
-    static EUCKREncodingIndex* table;
-    static std::once_flag once;
-    std::call_once(once, [&] {
-        table = new EUCKREncodingIndex;
-        auto& index = eucKR();
-        for (size_t i = 0; i < index.size(); i++)
-            (*table)[i] = { index[i].second, index[i].first };
-        sortByFirst(*table);
-        ASSERT(sortedFirstsAreUnique(*table));
-    });
-    return *table;
-}
-
 // https://encoding.spec.whatwg.org/#euc-kr-encoder
 static Vector<uint8_t> eucKREncode(StringView string, Function<void(UChar32, Vector<uint8_t>&)>&& unencodableHandler)
 {
@@ -719,7 +730,7 @@ static Vector<uint8_t> eucKREncode(StringView string, Function<void(UChar32, Vec
             continue;
         }
         
-        auto pointer = findFirstInSortedPairs(eucKREncodingIndex(), codePoint);
+        auto pointer = eucKRPointer(codePoint);
         if (!pointer) {
             unencodableHandler(codePoint, result);
             continue;
@@ -736,7 +747,7 @@ String TextCodecCJK::eucKRDecode(const uint8_t* bytes, size_t length, bool flush
     return decodeCommon(bytes, length, flush, stopOnError, sawError, [this] (uint8_t byte, StringBuilder& result) {
         if (uint8_t lead = std::exchange(m_lead, 0x00)) {
             if (byte >= 0x41 && byte <= 0xFE) {
-                if (auto codePoint = findFirstInSortedPairs(eucKR(), (lead - 0x81) * 190 + byte - 0x41)) {
+                if (auto codePoint = eucKRCodePoint((lead - 0x81) * 190 + byte - 0x41)) {
                     result.append(*codePoint);
                     return SawError::No;
                 }
@@ -43,7 +43,7 @@ private:
     Vector<uint8_t> encode(StringView, UnencodableHandling) const final;
 
     enum class SawError : bool { No, Yes };
-    String decodeCommon(const uint8_t*, size_t, bool, bool, bool&, const Function<SawError(uint8_t, StringBuilder&)>&);
+    template<typename ByteParser> String decodeCommon(const uint8_t*, size_t, bool, bool, bool&, const ByteParser&);
 
     String eucJPDecode(const uint8_t*, size_t, bool, bool, bool&);
     String iso2022JPDecode(const uint8_t*, size_t, bool, bool, bool&);
@@ -32,6 +32,12 @@
 #include <wtf/text/WTFString.h>
 #include <wtf/unicode/CharacterNames.h>
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 namespace WebCore {
 
 using namespace WTF::Unicode;
@@ -170,6 +176,82 @@ static inline UChar* appendCharacter(UChar* destination, int character)
     return destination;
 }
 
+#if CPU(X86_SSE2) || HAVE(ARM_NEON_INTRINSICS)
+
+static const size_t asciiVectorSize = 16;
+
+#if CPU(X86_SSE2)
+using ASCIIVector = __m128i;
+
+static inline ASCIIVector loadASCIIVector(const uint8_t* source) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)); }
+static inline bool isAllASCII(ASCIIVector vector) { return !_mm_movemask_epi8(vector); }
+static inline void storeASCIIVector(LChar* destination, ASCIIVector vector) { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), vector); }
+static inline void storeASCIIVector(UChar* destination, ASCIIVector vector)
+{
+    __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_unpacklo_epi8(vector, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 8), _mm_unpackhi_epi8(vector, zero));
+}
+#else
+using ASCIIVector = uint8x16_t;
+
+static inline ASCIIVector loadASCIIVector(const uint8_t* source) { return vld1q_u8(source); }
+static inline bool isAllASCII(ASCIIVector vector)
+{
+    uint64x2_t highBits = vreinterpretq_u64_u8(vandq_u8(vector, vdupq_n_u8(0x80)));
+    return !(vgetq_lane_u64(highBits, 0) | vgetq_lane_u64(highBits, 1));
+}
+static inline void storeASCIIVector(LChar* destination, ASCIIVector vector) { vst1q_u8(destination, vector); }
+static inline void storeASCIIVector(UChar* destination, ASCIIVector vector)
+{
+    vst1q_u16(reinterpret_cast<uint16_t*>(destination), vmovl_u8(vget_low_u8(vector)));
+    vst1q_u16(reinterpret_cast<uint16_t*>(destination + 8), vmovl_u8(vget_high_u8(vector)));
+}
+#endif
+
+// Copies ASCII bytes 16 at a time. Unaligned loads let the fast path resume right after a
+// non-ASCII sequence, where the machine word loop would first have to reach an aligned
+// address; that matters for non-Latin text, which interleaves markup and multibyte runs.
+// Returns at the first non-ASCII byte or when fewer than 16 bytes are left.
+template<typename CharacterType>
+static inline const uint8_t* copyASCII(CharacterType*& destination, const uint8_t* source, const uint8_t* end)
+{
+    while (static_cast<size_t>(end - source) >= asciiVectorSize) {
+        auto vector = loadASCIIVector(source);
+        if (!isAllASCII(vector)) {
+            while (isASCII(*source))
+                *destination++ = *source++;
+            break;
+        }
+        storeASCIIVector(destination, vector);
+        source += asciiVectorSize;
+        destination += asciiVectorSize;
+    }
+    return source;
+}
+
+#else
+
+template<typename CharacterType>
+static inline const uint8_t* copyASCII(CharacterType*& destination, const uint8_t* source, const uint8_t* end)
+{
+    if (!WTF::isAlignedToMachineWord(source))
+        return source;
+
+    const uint8_t* alignedEnd = WTF::alignToMachineWord(end);
+    while (source < alignedEnd) {
+        auto chunk = *reinterpret_cast_ptr<const WTF::MachineWord*>(source);
+        if (!WTF::isAllASCII<LChar>(chunk))
+            break;
+        copyASCIIMachineWord(destination, source);
+        source += sizeof(WTF::MachineWord);
+        destination += sizeof(WTF::MachineWord);
+    }
+    return source;
+}
+
+#endif
+
 void TextCodecUTF8::consumePartialSequenceByte()
 {
     --m_partialSequenceSize;
@@ -285,7 +367,6 @@ String TextCodecUTF8::decode(const char* bytes, size_t length, bool flush, bool
 
     const uint8_t* source = reinterpret_cast<const uint8_t*>(bytes);
     const uint8_t* end = source + length;
-    const uint8_t* alignedEnd = WTF::alignToMachineWord(end);
     LChar* destination = buffer.characters();
 
     do {
@@ -308,20 +389,11 @@ String TextCodecUTF8::decode(const char* bytes, size_t length, bool flush, bool
         while (source < end) {
             if (isASCII(*source)) {
                 // Fast path for ASCII. Most UTF-8 text will be ASCII.
-                if (WTF::isAlignedToMachineWord(source)) {
-                    while (source < alignedEnd) {
-                        auto chunk = *reinterpret_cast_ptr<const WTF::MachineWord*>(source);
-                        if (!WTF::isAllASCII<LChar>(chunk))
-                            break;
-                        copyASCIIMachineWord(destination, source);
-                        source += sizeof(WTF::MachineWord);
-                        destination += sizeof(WTF::MachineWord);
-                    }
-                    if (source == end)
-                        break;
-                    if (!isASCII(*source))
-                        continue;
-                }
+                source = copyASCII(destination, source, end);
+                if (source == end)
+                    break;
+                if (!isASCII(*source))
+                    continue;
                 *destination++ = *source++;
                 continue;
             }
@@ -388,20 +460,11 @@ upConvertTo16Bit:
         while (source < end) {
             if (isASCII(*source)) {
                 // Fast path for ASCII. Most UTF-8 text will be ASCII.
-                if (WTF::isAlignedToMachineWord(source)) {
-                    while (source < alignedEnd) {
-                        auto chunk = *reinterpret_cast_ptr<const WTF::MachineWord*>(source);
-                        if (!WTF::isAllASCII<LChar>(chunk))
-                            break;
-                        copyASCIIMachineWord(destination16, source);
-                        source += sizeof(WTF::MachineWord);
-                        destination16 += sizeof(WTF::MachineWord);
-                    }
-                    if (source == end)
-                        break;
-                    if (!isASCII(*source))
-                        continue;
-                }
+                source = copyASCII(destination16, source, end);
+                if (source == end)
+                    break;
+                if (!isASCII(*source))
+                    continue;
                 *destination16++ = *source++;
                 continue;
             }
@@ -34,6 +34,7 @@
 #include <stdlib.h>
 #include <wtf/FileSystem.h>
 #include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/TinyLRUCache.h>
 #include <wtf/text/AtomStringHash.h>
@@ -265,41 +266,68 @@ static void countLeadingSpaces(const CString& utf8String, int32_t& pointerOffset
     }
 }
 
-size_t lastHyphenLocation(StringView string, size_t beforeIndex, const AtomString& localeIdentifier)
-{
-    // libhyphen accepts strings in UTF-8 format, but WebCore can only provide StringView
-    // which stores either UTF-16 or Latin1 data. This is unfortunate for performance
-    // reasons and we should consider switching to a more flexible hyphenation library
-    // if it is available.
-    CString utf8StringCopy = string.toStringWithoutCopying().utf8();
+// Hyphenation points of a word, relative to its first character, for each dictionary of the locale in turn.
+using HyphenationPoints = Vector<Vector<unsigned>>;
 
-    // WebCore often passes strings like " wordtohyphenate" to the platform layer. Since
-    // libhyphen isn't advanced enough to deal with leading spaces (presumably CoreFoundation
-    // can), we should find the appropriate indexes into the string to skip them.
-    int32_t leadingSpaceBytes;
-    int32_t leadingSpaceCharacters;
-    countLeadingSpaces(utf8StringCopy, leadingSpaceBytes, leadingSpaceCharacters);
+// Justified text asks for the hyphenation points of the same words over and over, while pattern
+// matching in libhyphen is comparatively slow, so remember the points of recently hyphenated words.
+class HyphenationWordCache {
+    WTF_MAKE_NONCOPYABLE(HyphenationWordCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    HyphenationWordCache() = default;
 
+    static HyphenationWordCache& forLocale(const AtomString& lowercaseLocaleIdentifier)
+    {
+        static NeverDestroyed<HashMap<AtomString, std::unique_ptr<HyphenationWordCache>>> caches;
+        return *caches.get().ensure(lowercaseLocaleIdentifier, [] {
+            return makeUnique<HyphenationWordCache>();
+        }).iterator->value;
+    }
+
+    const HyphenationPoints* get(const String& word)
+    {
+        auto iterator = m_points.find(word);
+        if (iterator == m_points.end())
+            return nullptr;
+        m_wordsInUseOrder.appendOrMoveToLast(word);
+        return &iterator->value;
+    }
+
+    const HyphenationPoints& add(const String& word, HyphenationPoints&& points)
+    {
+        if (m_points.size() >= capacity)
+            m_points.remove(m_wordsInUseOrder.takeFirst());
+        m_wordsInUseOrder.add(word);
+        return m_points.add(word, WTFMove(points)).iterator->value;
+    }
+
+private:
+    static constexpr unsigned capacity = 2048;
+
+    HashMap<String, HyphenationPoints> m_points;
+    ListHashSet<String> m_wordsInUseOrder;
+};
+
+static HyphenationPoints computeHyphenationPoints(const CString& utf8String, int32_t leadingSpaceBytes, const Vector<String>& dictionaryPaths)
+{
     // The libhyphen documentation specifies that this array should be 5 bytes longer than
     // the byte length of the input string.
-    Vector<char> hyphenArray(utf8StringCopy.length() - leadingSpaceBytes + 5);
+    unsigned wordLength = utf8String.length() - leadingSpaceBytes;
+    Vector<char> hyphenArray(wordLength + 5);
     char* hyphenArrayData = hyphenArray.data();
 
-    String lowercaseLocaleIdentifier = AtomString(localeIdentifier.string().convertToASCIILowercase());
-
-    // Web content may specify strings for locales which do not exist or that we do not have.
-    if (!availableLocales().contains(lowercaseLocaleIdentifier))
-        return 0;
-
-    for (const auto& dictionaryPath : availableLocales().get(lowercaseLocaleIdentifier)) {
+    HyphenationPoints points;
+    points.reserveInitialCapacity(dictionaryPaths.size());
+    for (const auto& dictionaryPath : dictionaryPaths) {
         RefPtr<HyphenationDictionary> dictionary = WTF::TinyLRUCachePolicy<AtomString, RefPtr<HyphenationDictionary>>::cache().get(AtomString(dictionaryPath));
 
         char** replacements = nullptr;
         int* positions = nullptr;
         int* removedCharacterCounts = nullptr;
         hnj_hyphen_hyphenate2(dictionary->libhyphenDictionary(),
-            utf8StringCopy.data() + leadingSpaceBytes,
-            utf8StringCopy.length() - leadingSpaceBytes,
+            utf8String.data() + leadingSpaceBytes,
+            wordLength,
             hyphenArrayData,
             nullptr, /* output parameter for hyphenated word */
             &replacements,
@@ -307,7 +335,7 @@ size_t lastHyphenLocation(StringView string, size_t beforeIndex, const AtomStrin
             &removedCharacterCounts);
 
         if (replacements) {
-            for (unsigned i = 0; i < utf8StringCopy.length() - leadingSpaceBytes - 1; i++)
+            for (unsigned i = 0; i < wordLength - 1; i++)
                 free(replacements[i]);
             free(replacements);
         }
@@ -315,11 +343,53 @@ size_t lastHyphenLocation(StringView string, size_t beforeIndex, const AtomStrin
         free(positions);
         free(removedCharacterCounts);
 
-        for (int i = beforeIndex - leadingSpaceCharacters - 2; i >= 0; i--) {
-            // libhyphen will put an odd number in hyphenArrayData at all
-            // hyphenation points. A number & 1 will be true for odd numbers.
+        // libhyphen will put an odd number in hyphenArrayData at all
+        // hyphenation points. A number & 1 will be true for odd numbers.
+        Vector<unsigned> dictionaryPoints;
+        for (unsigned i = 0; i < wordLength; i++) {
             if (hyphenArrayData[i] & 1)
-                return i + 1 + leadingSpaceCharacters;
+                dictionaryPoints.append(i + 1);
+        }
+        points.uncheckedAppend(WTFMove(dictionaryPoints));
+    }
+    return points;
+}
+
+size_t lastHyphenLocation(StringView string, size_t beforeIndex, const AtomString& localeIdentifier)
+{
+    // libhyphen accepts strings in UTF-8 format, but WebCore can only provide StringView
+    // which stores either UTF-16 or Latin1 data. This is unfortunate for performance
+    // reasons and we should consider switching to a more flexible hyphenation library
+    // if it is available.
+    CString utf8StringCopy = string.toStringWithoutCopying().utf8();
+
+    // WebCore often passes strings like " wordtohyphenate" to the platform layer. Since
+    // libhyphen isn't advanced enough to deal with leading spaces (presumably CoreFoundation
+    // can), we should find the appropriate indexes into the string to skip them.
+    int32_t leadingSpaceBytes;
+    int32_t leadingSpaceCharacters;
+    countLeadingSpaces(utf8StringCopy, leadingSpaceBytes, leadingSpaceCharacters);
+    if (static_cast<unsigned>(leadingSpaceBytes) == utf8StringCopy.length())
+        return 0;
+
+    AtomString lowercaseLocaleIdentifier(localeIdentifier.string().convertToASCIILowercase());
+
+    // Web content may specify strings for locales which do not exist or that we do not have.
+    auto iterator = availableLocales().find(lowercaseLocaleIdentifier);
+    if (iterator == availableLocales().end())
+        return 0;
+
+    auto& wordCache = HyphenationWordCache::forLocale(lowercaseLocaleIdentifier);
+    String word = string.substring(leadingSpaceCharacters).toString();
+    auto* points = wordCache.get(word);
+    if (!points)
+        points = &wordCache.add(word, computeHyphenationPoints(utf8StringCopy, leadingSpaceBytes, iterator->value));
+
+    int lastAllowedPoint = static_cast<int>(beforeIndex) - leadingSpaceCharacters - 1;
+    for (auto& dictionaryPoints : *points) {
+        for (size_t i = dictionaryPoints.size(); i--;) {
+            if (static_cast<int>(dictionaryPoints[i]) <= lastAllowedPoint)
+                return dictionaryPoints[i] + leadingSpaceCharacters;
         }
     }
 
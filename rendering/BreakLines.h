@@ -23,7 +23,10 @@
 
 #include <unicode/ubrk.h>
 #include <wtf/ASCIICType.h>
+#include <wtf/BitVector.h>
+#include <wtf/RefCounted.h>
 #include <wtf/StdLibExtras.h>
+#include <wtf/text/AtomString.h>
 #include <wtf/text/TextBreakIterator.h>
 #include <wtf/unicode/CharacterNames.h>
 
@@ -224,4 +227,84 @@ inline bool isBreakable(LazyLineBreakIterator& lazyBreakIterator, unsigned start
     return startPosition == nextBreakable;
 }
 
+// The break opportunities of a whole string, computed in one pass with the same rules as isBreakable() so that
+// repeated layouts of unchanged text can look them up instead of walking the text and the ICU iterator again.
+// They are computed without prior context. The prior context only affects the first position, which isBreakable()
+// therefore answers with the caller's iterator, so one set of opportunities serves every caller.
+// line-break: anywhere is not supported; isBreakable() answers it relative to the previously queried position.
+class LineBreakOpportunities : public RefCounted<LineBreakOpportunities> {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static Ref<LineBreakOpportunities> create(const String& text, LineBreakIteratorMode mode, const AtomString& locale, bool breakNBSP, bool canUseShortcut, bool keepAllWords)
+    {
+        return adoptRef(*new LineBreakOpportunities(text, mode, locale, breakNBSP, canUseShortcut, keepAllWords));
+    }
+
+    bool hasTextAndOptions(const String& text, LineBreakIteratorMode mode, const AtomString& locale, bool breakNBSP, bool canUseShortcut, bool keepAllWords) const
+    {
+        return m_text.impl() == text.impl()
+            && m_mode == mode
+            && m_locale == locale
+            && m_breakNBSP == breakNBSP
+            && m_canUseShortcut == canUseShortcut
+            && m_keepAllWords == keepAllWords;
+    }
+
+    unsigned nextBreakablePosition(unsigned startPosition) const
+    {
+        if (startPosition >= m_text.length())
+            return m_text.length();
+        return std::min<size_t>(m_breakablePositions.findBit(startPosition, true), m_text.length());
+    }
+
+    // Same contract as isBreakable() above. The iterator is only used for the first position, and only when it
+    // carries prior context.
+    bool isBreakable(LazyLineBreakIterator& lazyBreakIterator, unsigned startPosition, Optional<unsigned>& nextBreakable) const
+    {
+        if (!nextBreakable || nextBreakable.value() < startPosition) {
+            if (!startPosition && !m_text.isEmpty() && lazyBreakIterator.lastCharacter())
+                nextBreakable = isBreakableAtStart(lazyBreakIterator) ? 0 : nextBreakablePosition(1);
+            else
+                nextBreakable = nextBreakablePosition(startPosition);
+        }
+        return startPosition == nextBreakable;
+    }
+
+private:
+    LineBreakOpportunities(const String& text, LineBreakIteratorMode mode, const AtomString& locale, bool breakNBSP, bool canUseShortcut, bool keepAllWords)
+        : m_text(text)
+        , m_locale(locale)
+        , m_mode(mode)
+        , m_breakNBSP(breakNBSP)
+        , m_canUseShortcut(canUseShortcut)
+        , m_keepAllWords(keepAllWords)
+    {
+        LazyLineBreakIterator lazyBreakIterator(text, locale, mode);
+        unsigned length = text.length();
+        m_breakablePositions.ensureSize(length);
+        Optional<unsigned> nextBreakable;
+        for (unsigned position = 0; position < length; position = *nextBreakable + 1) {
+            WebCore::isBreakable(lazyBreakIterator, position, nextBreakable, breakNBSP, canUseShortcut, keepAllWords, false);
+            if (*nextBreakable >= length)
+                break;
+            m_breakablePositions.quickSet(*nextBreakable);
+        }
+    }
+
+    bool isBreakableAtStart(LazyLineBreakIterator& lazyBreakIterator) const
+    {
+        ASSERT(lazyBreakIterator.stringView() == StringView(m_text));
+        Optional<unsigned> nextBreakable;
+        return WebCore::isBreakable(lazyBreakIterator, 0, nextBreakable, m_breakNBSP, m_canUseShortcut, m_keepAllWords, false);
+    }
+
+    String m_text;
+    AtomString m_locale;
+    LineBreakIteratorMode m_mode;
+    bool m_breakNBSP;
+    bool m_canUseShortcut;
+    bool m_keepAllWords;
+    BitVector m_breakablePositions;
+};
+
 } // namespace WebCore
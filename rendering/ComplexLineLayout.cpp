@@ -1171,6 +1171,41 @@ static inline void setUpResolverToResumeInIsolate(InlineBidiResolver& resolver,
     notifyResolverToResumeInIsolate(resolver, root, startObject);
 }
 
+// Observer for bidiNextSkippingEmptyInlines() that notes whether any inline it enters or leaves affects bidi levels.
+class BidiEmbeddingDetector {
+public:
+    bool hasEmbedding() const { return m_hasEmbedding; }
+
+    bool inIsolate() const { return false; }
+    void enterIsolate() { m_hasEmbedding = true; }
+    void exitIsolate() { m_hasEmbedding = true; }
+    void embed(UCharDirection, BidiEmbeddingSource) { m_hasEmbedding = true; }
+    bool commitExplicitEmbedding() { return false; }
+
+private:
+    bool m_hasEmbedding { false };
+};
+
+static bool lineHasOnlyLeftToRightContent(const InlineIterator& start, const InlineIterator& end)
+{
+    if (!start.root())
+        return false;
+
+    BidiEmbeddingDetector embeddingDetector;
+    for (auto* renderer = start.renderer(); renderer; renderer = bidiNextSkippingEmptyInlines(*start.root(), renderer, &embeddingDetector)) {
+        if (embeddingDetector.hasEmbedding())
+            return false;
+        if (is<RenderText>(*renderer)) {
+            if (downcast<RenderText>(*renderer).hasRightToLeftOrBidiControlCharacters())
+                return false;
+        } else if (renderer->isListMarker() && !renderer->style().isLeftToRightDirection())
+            return false;
+        if (renderer == end.renderer())
+            return true;
+    }
+    return !embeddingDetector.hasEmbedding();
+}
+
 // FIXME: BidiResolver should have this logic.
 static inline void constructBidiRunsForSegment(InlineBidiResolver& topResolver, BidiRunList<BidiRun>& bidiRuns, const InlineIterator& endOfRuns, VisualDirectionOverride override, bool previousLineBrokeCleanly)
 {
@@ -1179,6 +1214,11 @@ static inline void constructBidiRunsForSegment(InlineBidiResolver& topResolver,
     ASSERT(&topResolver.runs() == &bidiRuns);
     ASSERT(topResolver.position() != endOfRuns);
     RenderObject* currentRoot = topResolver.position().root();
+    if (override == NoVisualOverride && topResolver.canCreateLeftToRightRunsForLine() && lineHasOnlyLeftToRightContent(topResolver.position(), endOfRuns)) {
+        topResolver.createLeftToRightRunsForLine(endOfRuns);
+        ASSERT(topResolver.isolatedRuns().isEmpty());
+        return;
+    }
     topResolver.createBidiRunsForLine(endOfRuns, override, previousLineBrokeCleanly);
 
     while (!topResolver.isolatedRuns().isEmpty()) {
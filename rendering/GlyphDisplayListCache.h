@@ -30,11 +30,24 @@
 #include "Logging.h"
 #include "TextRun.h"
 #include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/ListHashSet.h>
 #include <wtf/MemoryPressureHandler.h>
 #include <wtf/NeverDestroyed.h>
 
 namespace WebCore {
 
+struct GlyphDisplayListCacheStatistics {
+    unsigned hitCount { 0 };
+    unsigned missCount { 0 };
+    unsigned evictionCount { 0 };
+    unsigned size { 0 };
+    size_t sizeInBytes { 0 };
+};
+
+// Glyph display lists are shared by all the runs that paint the same text with the same font and layout
+// parameters, whichever box or document they belong to. Runs map to their shared entry until they are
+// destroyed; entries themselves are evicted in least recently used order once the byte budget is exceeded.
 template<typename LayoutRun>
 class GlyphDisplayListCache {
 public:
@@ -49,48 +62,195 @@ public:
     DisplayList::DisplayList* get(const LayoutRun& run, const FontCascade& font, GraphicsContext& context, const TextRun& textRun)
     {
         if (MemoryPressureHandler::singleton().isUnderMemoryPressure()) {
-            if (!m_glyphRunMap.isEmpty()) {
+            if (!m_entries.isEmpty()) {
                 LOG(MemoryPressure, "GlyphDisplayListCache::%s - Under memory pressure - size: %d - sizeInBytes: %ld", __FUNCTION__, size(), sizeInBytes());
                 clear();
             }
             return nullptr;
         }
 
-        if (auto displayList = m_glyphRunMap.get(&run))
-            return displayList;
+        if (auto* entry = m_runMap.get(&run)) {
+            ++m_statistics.hitCount;
+            m_entriesInUseOrder.appendOrMoveToLast(entry);
+            return entry->displayList.get();
+        }
+
+        if (textRun.text().isEmpty())
+            return nullptr;
 
-        if (auto displayList = font.displayListForTextRun(context, textRun))
-            return m_glyphRunMap.add(&run, WTFMove(displayList)).iterator->value.get();
+        Key key(font, textRun);
+        auto* entry = m_entries.get(key);
+        if (entry)
+            ++m_statistics.hitCount;
+        else {
+            ++m_statistics.missCount;
+            auto displayList = font.displayListForTextRun(context, textRun);
+            if (!displayList)
+                return nullptr;
 
-        return nullptr;
+            auto newEntry = makeUnique<Entry>(Entry { key, WTFMove(displayList), { }, 0 });
+            newEntry->sizeInBytes = newEntry->displayList->sizeInBytes();
+            m_sizeInBytes += newEntry->sizeInBytes;
+            entry = m_entries.add(WTFMove(key), WTFMove(newEntry)).iterator->value.get();
+        }
+
+        entry->runs.add(&run);
+        m_runMap.add(&run, entry);
+        m_entriesInUseOrder.appendOrMoveToLast(entry);
+        pruneToSize(maximumSizeInBytes);
+        return entry->displayList.get();
     }
 
     void remove(const LayoutRun& run)
     {
-        m_glyphRunMap.remove(&run);
+        // The entry stays cached for other runs with the same content until it gets evicted.
+        if (auto* entry = m_runMap.take(&run))
+            entry->runs.remove(&run);
     }
 
     void clear()
     {
-        m_glyphRunMap.clear();
+        m_runMap.clear();
+        m_entriesInUseOrder.clear();
+        m_entries.clear();
+        m_sizeInBytes = 0;
     }
 
     unsigned size() const
     {
-        return m_glyphRunMap.size();
+        return m_entries.size();
     }
     
     size_t sizeInBytes() const
     {
-        size_t sizeInBytes = 0;
-        for (const auto& entry : m_glyphRunMap)
-            sizeInBytes += entry.value->sizeInBytes();
-        return sizeInBytes;
+        return m_sizeInBytes;
     }
-    
+
+    GlyphDisplayListCacheStatistics statistics() const
+    {
+        auto statistics = m_statistics;
+        statistics.size = size();
+        statistics.sizeInBytes = sizeInBytes();
+        return statistics;
+    }
+
+    void resetStatistics() { m_statistics = { }; }
+
 private:
-    using GlyphRunMap = HashMap<const LayoutRun*, std::unique_ptr<DisplayList::DisplayList>>;
-    GlyphRunMap m_glyphRunMap;
+    static constexpr size_t maximumSizeInBytes = 4 * MB;
+
+    struct Key {
+        Key() = default;
+
+        Key(const FontCascade& font, const TextRun& textRun)
+            : text(textRun.text().toString())
+            , fonts(font.fonts())
+            , letterSpacing(font.letterSpacing())
+            , wordSpacing(font.wordSpacing())
+            , horizontalGlyphStretch(textRun.horizontalGlyphStretch())
+            , expansion(textRun.expansion())
+            , expansionBehavior(textRun.expansionBehavior())
+            , direction(textRun.direction())
+            , directionalOverride(textRun.directionalOverride())
+            , characterScanForCodePath(textRun.characterScanForCodePath())
+            , spacingDisabled(textRun.spacingDisabled())
+            , allowTabs(textRun.allowTabs())
+        {
+            // Tab stops depend on where the run starts, so the position only matters for runs with tabs.
+            if (allowTabs) {
+                xPos = textRun.xPos();
+                tabSize = textRun.tabSize();
+            }
+        }
+
+        explicit Key(WTF::HashTableDeletedValueType)
+            : text(WTF::HashTableDeletedValue)
+        {
+        }
+
+        bool isHashTableDeletedValue() const { return text.isHashTableDeletedValue(); }
+
+        bool operator==(const Key& other) const
+        {
+            return text == other.text
+                && fonts == other.fonts
+                && letterSpacing == other.letterSpacing
+                && wordSpacing == other.wordSpacing
+                && horizontalGlyphStretch == other.horizontalGlyphStretch
+                && expansion == other.expansion
+                && expansionBehavior == other.expansionBehavior
+                && direction == other.direction
+                && directionalOverride == other.directionalOverride
+                && characterScanForCodePath == other.characterScanForCodePath
+                && spacingDisabled == other.spacingDisabled
+                && allowTabs == other.allowTabs
+                && xPos == other.xPos
+                && tabSize == other.tabSize;
+        }
+
+        unsigned hash() const
+        {
+            unsigned hash = WTF::pairIntHash(text.impl()->hash(), WTF::PtrHash<FontCascadeFonts*>::hash(fonts.get()));
+            hash = WTF::pairIntHash(hash, WTF::pairIntHash(bitwise_cast<unsigned>(letterSpacing), bitwise_cast<unsigned>(wordSpacing)));
+            hash = WTF::pairIntHash(hash, WTF::pairIntHash(bitwise_cast<unsigned>(expansion), bitwise_cast<unsigned>(xPos)));
+            return WTF::pairIntHash(hash, static_cast<unsigned>(direction) | directionalOverride << 1 | allowTabs << 2);
+        }
+
+        String text;
+        // Keeping the fonts alive makes sure a new FontCascadeFonts allocated at the same address is never mistaken for this one.
+        RefPtr<FontCascadeFonts> fonts;
+        float letterSpacing { 0 };
+        float wordSpacing { 0 };
+        float horizontalGlyphStretch { 1 };
+        float expansion { 0 };
+        ExpansionBehavior expansionBehavior { DefaultExpansion };
+        TextDirection direction { TextDirection::LTR };
+        bool directionalOverride { false };
+        bool characterScanForCodePath { true };
+        bool spacingDisabled { false };
+        bool allowTabs { false };
+        float xPos { 0 };
+        TabSize tabSize { 0 };
+    };
+
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return key.hash(); }
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = false;
+    };
+
+    struct KeyHashTraits : SimpleClassHashTraits<Key> {
+        static const bool hasIsEmptyValueFunction = true;
+        static bool isEmptyValue(const Key& key) { return key.text.isNull(); }
+    };
+
+    struct Entry {
+        WTF_MAKE_STRUCT_FAST_ALLOCATED;
+        Key key;
+        std::unique_ptr<DisplayList::DisplayList> displayList;
+        HashSet<const LayoutRun*> runs;
+        size_t sizeInBytes;
+    };
+
+    void pruneToSize(size_t maximumSize)
+    {
+        // The most recently used entry is never evicted, the caller is about to replay it.
+        while (m_sizeInBytes > maximumSize && m_entriesInUseOrder.size() > 1) {
+            auto* entry = m_entriesInUseOrder.takeFirst();
+            for (auto* run : entry->runs)
+                m_runMap.remove(run);
+            m_sizeInBytes -= entry->sizeInBytes;
+            ++m_statistics.evictionCount;
+            auto key = entry->key;
+            m_entries.remove(key);
+        }
+    }
+
+    HashMap<Key, std::unique_ptr<Entry>, KeyHash, KeyHashTraits> m_entries;
+    HashMap<const LayoutRun*, Entry*> m_runMap;
+    ListHashSet<Entry*> m_entriesInUseOrder;
+    size_t m_sizeInBytes { 0 };
+    GlyphDisplayListCacheStatistics m_statistics;
 };
     
 }
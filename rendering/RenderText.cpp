@@ -59,6 +59,12 @@
 #include <wtf/text/TextBreakIterator.h>
 #include <wtf/unicode/CharacterNames.h>
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 #if PLATFORM(IOS_FAMILY)
 #include "Document.h"
 #include "EditorClient.h"
@@ -144,6 +150,12 @@ static HashMap<const RenderText*, WeakPtr<RenderInline>>& inlineWrapperForDispla
     return map;
 }
 
+static HashMap<const RenderText*, RefPtr<LineBreakOpportunities>>& lineBreakOpportunitiesMap()
+{
+    static NeverDestroyed<HashMap<const RenderText*, RefPtr<LineBreakOpportunities>>> map;
+    return map;
+}
+
 static constexpr UChar convertNoBreakSpaceToSpace(UChar character)
 {
     return character == noBreakSpace ? ' ' : character;
@@ -193,6 +205,9 @@ inline RenderText::RenderText(Node& node, const String& text)
     , m_useBackslashAsYenSymbol(false)
     , m_originalTextDiffersFromRendered(false)
     , m_hasInlineWrapperForDisplayContents(false)
+    , m_hasLineBreakOpportunities(false)
+    , m_hasComputedRightToLeftOrBidiControlCharacters(false)
+    , m_hasRightToLeftOrBidiControlCharacters(false)
     , m_text(text)
 {
     ASSERT(!m_text.isNull());
@@ -214,6 +229,7 @@ RenderText::~RenderText()
 {
     // Do not add any code here. Add it to willBeDestroyed() instead.
     ASSERT(!originalTextMap().contains(this));
+    ASSERT(!lineBreakOpportunitiesMap().contains(this));
 }
 
 const char* RenderText::renderName() const
@@ -296,6 +312,7 @@ void RenderText::willBeDestroyed()
         originalTextMap().remove(this);
 
     setInlineWrapperForDisplayContents(nullptr);
+    clearLineBreakOpportunities();
 
     RenderObject::willBeDestroyed();
 }
@@ -1020,6 +1037,12 @@ void RenderText::computePreferredLogicalWidths(float leadWidth, HashSet<const Fo
     bool breakAll = (style.wordBreak() == WordBreak::BreakAll || style.wordBreak() == WordBreak::BreakWord) && style.autoWrap();
     bool keepAllWords = style.wordBreak() == WordBreak::KeepAll;
     bool canUseLineBreakShortcut = iteratorMode == LineBreakIteratorMode::Default;
+    RefPtr<const LineBreakOpportunities> lineBreakOpportunities = breakAnywhere ? nullptr : &this->lineBreakOpportunities(breakIterator, style.computedLocale(), breakNBSP, canUseLineBreakShortcut, keepAllWords);
+    auto isBreakableAt = [&](unsigned position) {
+        if (lineBreakOpportunities)
+            return lineBreakOpportunities->isBreakable(breakIterator, position, nextBreakable);
+        return isBreakable(breakIterator, position, nextBreakable, breakNBSP, canUseLineBreakShortcut, keepAllWords, breakAnywhere);
+    };
 
     for (unsigned i = 0; i < length; i++) {
         UChar c = string[i];
@@ -1065,7 +1088,7 @@ void RenderText::computePreferredLogicalWidths(float leadWidth, HashSet<const Fo
             continue;
         }
 
-        bool hasBreak = breakAll || isBreakable(breakIterator, i, nextBreakable, breakNBSP, canUseLineBreakShortcut, keepAllWords, breakAnywhere);
+        bool hasBreak = breakAll || isBreakableAt(i);
         bool betweenWords = true;
         unsigned j = i;
         while (c != '\n' && !isSpaceAccordingToStyle(c, style) && c != '\t' && (c != softHyphen || style.hyphens() == Hyphens::None)) {
@@ -1073,7 +1096,7 @@ void RenderText::computePreferredLogicalWidths(float leadWidth, HashSet<const Fo
             if (j == length)
                 break;
             c = string[j];
-            if (isBreakable(breakIterator, j, nextBreakable, breakNBSP, canUseLineBreakShortcut, keepAllWords, breakAnywhere) && characterAt(j - 1) != softHyphen)
+            if (isBreakableAt(j) && characterAt(j - 1) != softHyphen)
                 break;
             if (breakAll) {
                 betweenWords = false;
@@ -1221,6 +1244,69 @@ bool RenderText::isAllCollapsibleWhitespace() const
     return WebCore::isAllCollapsibleWhitespace(text().characters16(), text().length(), style());
 }
 
+static bool isRightToLeftOrBidiControlCharacter(UChar32 character)
+{
+    switch (u_charDirection(character)) {
+    case U_RIGHT_TO_LEFT:
+    case U_RIGHT_TO_LEFT_ARABIC:
+    case U_ARABIC_NUMBER:
+    case U_LEFT_TO_RIGHT_EMBEDDING:
+    case U_RIGHT_TO_LEFT_EMBEDDING:
+    case U_LEFT_TO_RIGHT_OVERRIDE:
+    case U_RIGHT_TO_LEFT_OVERRIDE:
+    case U_POP_DIRECTIONAL_FORMAT:
+    case U_FIRST_STRONG_ISOLATE:
+    case U_LEFT_TO_RIGHT_ISOLATE:
+    case U_RIGHT_TO_LEFT_ISOLATE:
+    case U_POP_DIRECTIONAL_ISOLATE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Nothing before the Hebrew block is right-to-left or a bidi control character.
+static constexpr UChar firstPossiblyRightToLeftCharacter = 0x0590;
+
+static bool hasRightToLeftOrBidiControlCharacters(const UChar* characters, unsigned length)
+{
+    unsigned i = 0;
+    // Skip ahead 8 code units at a time while all of them are below the first right-to-left block.
+#if CPU(X86_SSE2)
+    __m128i lastLeftToRightCharacter = _mm_set1_epi16(firstPossiblyRightToLeftCharacter - 1);
+    for (; length - i >= 8; i += 8) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + i));
+        // Unsigned saturating subtraction leaves zero exactly for the code units below the limit.
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(chunk, lastLeftToRightCharacter), _mm_setzero_si128())) != 0xFFFF)
+            break;
+    }
+#elif HAVE(ARM_NEON_INTRINSICS)
+    uint16x8_t firstPossiblyRightToLeft = vdupq_n_u16(firstPossiblyRightToLeftCharacter);
+    for (; length - i >= 8; i += 8) {
+        uint64x2_t atOrAboveLimit = vreinterpretq_u64_u16(vcgeq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(characters + i)), firstPossiblyRightToLeft));
+        if (vgetq_lane_u64(atOrAboveLimit, 0) | vgetq_lane_u64(atOrAboveLimit, 1))
+            break;
+    }
+#endif
+    while (i < length) {
+        UChar32 character;
+        U16_NEXT(characters, i, length, character);
+        if (character >= firstPossiblyRightToLeftCharacter && isRightToLeftOrBidiControlCharacter(character))
+            return true;
+    }
+    return false;
+}
+
+bool RenderText::hasRightToLeftOrBidiControlCharacters() const
+{
+    if (!m_hasComputedRightToLeftOrBidiControlCharacters) {
+        // Latin-1 has no right-to-left or bidi control characters.
+        m_hasRightToLeftOrBidiControlCharacters = !text().is8Bit() && WebCore::hasRightToLeftOrBidiControlCharacters(text().characters16(), text().length());
+        m_hasComputedRightToLeftOrBidiControlCharacters = true;
+    }
+    return m_hasRightToLeftOrBidiControlCharacters;
+}
+
 template<typename CharacterType> static inline bool isAllPossiblyCollapsibleWhitespace(const CharacterType* characters, unsigned length)
 {
     for (unsigned i = 0; i < length; ++i) {
@@ -1334,6 +1420,8 @@ void RenderText::setRenderedText(const String& newText)
 {
     ASSERT(!newText.isNull());
 
+    clearLineBreakOpportunities();
+
     String originalText = this->originalText();
 
     m_text = newText;
@@ -1373,6 +1461,7 @@ void RenderText::setRenderedText(const String& newText)
     }
 
     m_isAllASCII = text().isAllASCII();
+    m_hasComputedRightToLeftOrBidiControlCharacters = false;
     m_canUseSimpleFontCodePath = computeCanUseSimpleFontCodePath();
     m_canUseSimplifiedTextMeasuring = computeCanUseSimplifiedTextMeasuring();
     
@@ -1810,6 +1899,27 @@ void RenderText::setInlineWrapperForDisplayContents(RenderInline* wrapper)
     m_hasInlineWrapperForDisplayContents = true;
 }
 
+const LineBreakOpportunities& RenderText::lineBreakOpportunities(LazyLineBreakIterator& lazyBreakIterator, const AtomString& locale, bool breakNBSP, bool canUseShortcut, bool keepAllWords)
+{
+    ASSERT(m_hasLineBreakOpportunities == lineBreakOpportunitiesMap().contains(this));
+
+    auto& opportunities = lineBreakOpportunitiesMap().add(this, nullptr).iterator->value;
+    if (!opportunities || !opportunities->hasTextAndOptions(m_text, lazyBreakIterator.mode(), locale, breakNBSP, canUseShortcut, keepAllWords))
+        opportunities = LineBreakOpportunities::create(m_text, lazyBreakIterator.mode(), locale, breakNBSP, canUseShortcut, keepAllWords);
+    m_hasLineBreakOpportunities = true;
+    return *opportunities;
+}
+
+void RenderText::clearLineBreakOpportunities()
+{
+    ASSERT(m_hasLineBreakOpportunities == lineBreakOpportunitiesMap().contains(this));
+
+    if (!m_hasLineBreakOpportunities)
+        return;
+    lineBreakOpportunitiesMap().remove(this);
+    m_hasLineBreakOpportunities = false;
+}
+
 RenderText* RenderText::findByDisplayContentsInlineWrapperCandidate(RenderElement& renderer)
 {
     auto* firstChild = renderer.firstChild();
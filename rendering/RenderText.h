@@ -32,6 +32,7 @@ namespace WebCore {
 
 class Font;
 class InlineTextBox;
+class LineBreakOpportunities;
 struct GlyphOverflow;
 
 namespace LayoutIntegration {
@@ -147,6 +148,9 @@ public:
     int nextOffset(int current) const final;
 
     bool containsReversedText() const { return m_containsReversedText; }
+    // Whether the text has characters that can make a left-to-right line need bidi reordering:
+    // right-to-left letters, Arabic numbers or bidi control characters.
+    bool hasRightToLeftOrBidiControlCharacters() const;
 
     void momentarilyRevealLastTypedCharacter(unsigned offsetAfterLastTypedCharacter);
 
@@ -182,6 +186,9 @@ public:
 
     static RenderText* findByDisplayContentsInlineWrapperCandidate(RenderElement&);
 
+    // Cached break opportunities of text(); lazyBreakIterator must be set up on text() and is only used if the cache is stale.
+    const LineBreakOpportunities& lineBreakOpportunities(LazyLineBreakIterator&, const AtomString& locale, bool breakNBSP, bool canUseShortcut, bool keepAllWords);
+
 protected:
     virtual void computePreferredLogicalWidths(float leadWidth);
     void willBeDestroyed() override;
@@ -214,6 +221,7 @@ private:
     bool computeUseBackslashAsYenSymbol() const;
 
     void secureText(UChar mask);
+    void clearLineBreakOpportunities();
 
     LayoutRect collectSelectionRectsForLineBoxes(const RenderLayerModelObject* repaintContainer, bool clipToVisibleContent, Vector<LayoutRect>*);
     bool computeCanUseSimplifiedTextMeasuring() const;
@@ -240,6 +248,9 @@ private:
     unsigned m_originalTextDiffersFromRendered : 1;
     unsigned m_hasInlineWrapperForDisplayContents : 1;
     unsigned m_canUseSimplifiedTextMeasuring : 1;
+    unsigned m_hasLineBreakOpportunities : 1;
+    mutable unsigned m_hasComputedRightToLeftOrBidiControlCharacters : 1;
+    mutable unsigned m_hasRightToLeftOrBidiControlCharacters : 1;
 
 #if ENABLE(TEXT_AUTOSIZING)
     // FIXME: This should probably be part of the text sizing structures in Document instead. That would save some memory.
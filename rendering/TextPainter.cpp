@@ -234,6 +234,31 @@ void TextPainter::clearGlyphDisplayLists()
 #endif
 }
 
+GlyphDisplayListCacheStatistics TextPainter::glyphDisplayListCacheStatistics()
+{
+    auto statistics = GlyphDisplayListCache<InlineTextBox>::singleton().statistics();
+#if ENABLE(LAYOUT_FORMATTING_CONTEXT)
+    if (RuntimeEnabledFeatures::sharedFeatures().layoutFormattingContextIntegrationEnabled()) {
+        auto runStatistics = GlyphDisplayListCache<LayoutIntegration::Run>::singleton().statistics();
+        statistics.hitCount += runStatistics.hitCount;
+        statistics.missCount += runStatistics.missCount;
+        statistics.evictionCount += runStatistics.evictionCount;
+        statistics.size += runStatistics.size;
+        statistics.sizeInBytes += runStatistics.sizeInBytes;
+    }
+#endif
+    return statistics;
+}
+
+void TextPainter::resetGlyphDisplayListCacheStatistics()
+{
+    GlyphDisplayListCache<InlineTextBox>::singleton().resetStatistics();
+#if ENABLE(LAYOUT_FORMATTING_CONTEXT)
+    if (RuntimeEnabledFeatures::sharedFeatures().layoutFormattingContextIntegrationEnabled())
+        GlyphDisplayListCache<LayoutIntegration::Run>::singleton().resetStatistics();
+#endif
+}
+
 bool TextPainter::shouldUseGlyphDisplayList(const PaintInfo& paintInfo)
 {
     return !paintInfo.context().paintingDisabled() && paintInfo.enclosingSelfPaintingLayer() && paintInfo.enclosingSelfPaintingLayer()->paintingFrequently();
@@ -73,7 +73,9 @@ public:
     template<typename LayoutRun>
     static void removeGlyphDisplayList(const LayoutRun& run) { GlyphDisplayListCache<LayoutRun>::singleton().remove(run); }
 
-    static void clearGlyphDisplayLists();
+    WEBCORE_EXPORT static void clearGlyphDisplayLists();
+    WEBCORE_EXPORT static GlyphDisplayListCacheStatistics glyphDisplayListCacheStatistics();
+    WEBCORE_EXPORT static void resetGlyphDisplayListCacheStatistics();
     static bool shouldUseGlyphDisplayList(const PaintInfo&);
 
 private:
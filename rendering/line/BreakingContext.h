@@ -732,11 +732,19 @@ inline bool BreakingContext::handleText(WordMeasurements& wordMeasurements, bool
         m_renderTextInfo.font = &font;
         m_renderTextInfo.layout = font.createLayout(renderText, m_width.currentWidth(), m_collapseWhiteSpace);
         m_renderTextInfo.lineBreakIterator.resetStringAndReleaseIterator(renderText.text(), style.computedLocale(), iteratorMode);
+        m_renderTextInfo.lineBreakOpportunities = nullptr;
     } else if (m_renderTextInfo.layout && m_renderTextInfo.font != &font) {
         m_renderTextInfo.font = &font;
         m_renderTextInfo.layout = font.createLayout(renderText, m_width.currentWidth(), m_collapseWhiteSpace);
     }
 
+    // Break opportunities are computed once per text and reused by the following lines and by preferred width computation.
+    if (breakAnywhere)
+        m_renderTextInfo.lineBreakOpportunities = nullptr;
+    else if (!m_renderTextInfo.lineBreakOpportunities || !m_renderTextInfo.lineBreakOpportunities->hasTextAndOptions(renderText.text(), iteratorMode, style.computedLocale(), breakNBSP, canUseLineBreakShortcut, keepAllWords))
+        m_renderTextInfo.lineBreakOpportunities = &renderText.lineBreakOpportunities(m_renderTextInfo.lineBreakIterator, style.computedLocale(), breakNBSP, canUseLineBreakShortcut, keepAllWords);
+    auto* lineBreakOpportunities = m_renderTextInfo.lineBreakOpportunities.get();
+
     HashSet<const Font*> fallbackFonts;
     m_hasFormerOpportunity = false;
     bool canBreakMidWord = breakWords || breakAll;
@@ -791,7 +799,12 @@ inline bool BreakingContext::handleText(WordMeasurements& wordMeasurements, bool
         }
 
         Optional<unsigned> nextBreakablePosition = m_current.nextBreakablePosition();
-        bool betweenWords = c == '\n' || (m_currWS != WhiteSpace::Pre && !m_atStart && isBreakable(m_renderTextInfo.lineBreakIterator, m_current.offset(), nextBreakablePosition, breakNBSP, canUseLineBreakShortcut, keepAllWords, breakAnywhere)
+        auto isBreakableAtCurrentOffset = [&] {
+            if (lineBreakOpportunities)
+                return lineBreakOpportunities->isBreakable(m_renderTextInfo.lineBreakIterator, m_current.offset(), nextBreakablePosition);
+            return isBreakable(m_renderTextInfo.lineBreakIterator, m_current.offset(), nextBreakablePosition, breakNBSP, canUseLineBreakShortcut, keepAllWords, breakAnywhere);
+        };
+        bool betweenWords = c == '\n' || (m_currWS != WhiteSpace::Pre && !m_atStart && isBreakableAtCurrentOffset()
             && (style.hyphens() != Hyphens::None || (m_current.previousInSameNode() != softHyphen)));
         m_current.setNextBreakablePosition(nextBreakablePosition);
         
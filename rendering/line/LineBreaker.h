@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "BreakLines.h"
 #include "InlineIterator.h"
 #include "LineInfo.h"
 #include "LineInlineHeaders.h"
@@ -38,6 +39,7 @@ struct RenderTextInfo {
     RenderText* text { nullptr };
     std::unique_ptr<TextLayout, TextLayoutDeleter> layout;
     LazyLineBreakIterator lineBreakIterator;
+    RefPtr<const LineBreakOpportunities> lineBreakOpportunities;
     const FontCascade* font { nullptr };
 };
 
@@ -59,6 +59,7 @@
 #include "DOMStringList.h"
 #include "DOMURL.h"
 #include "DOMWindow.h"
+#include "DecodedImageFrameCache.h"
 #include "DeprecatedGlobalSettings.h"
 #include "DiagnosticLoggingClient.h"
 #include "DisabledAdaptations.h"
@@ -183,6 +184,7 @@
 #include "ServiceWorkerRegistrationData.h"
 #include "Settings.h"
 #include "ShadowRoot.h"
+#include "SharedBuffer.h"
 #include "SourceBuffer.h"
 #include "SpellChecker.h"
 #include "StaticNodeList.h"
@@ -195,6 +197,7 @@
 #include "StyleSheetContents.h"
 #include "SystemSoundManager.h"
 #include "TextIterator.h"
+#include "TextPainter.h"
 #include "TextPlaceholderElement.h"
 #include "TreeScope.h"
 #include "TypeConversions.h"
@@ -312,6 +315,10 @@
 #include "PaymentCoordinator.h"
 #endif
 
+#if USE(HARFBUZZ)
+#include "ComplexTextRunCache.h"
+#endif
+
 #if ENABLE(WEBXR)
 #include "NavigatorWebXR.h"
 #include "WebXRSystem.h"
@@ -894,6 +901,64 @@ unsigned Internals::memoryCacheSize() const
     return MemoryCache::singleton().size();
 }
 
+static MemoryCache::ResourceCategory toMemoryCacheResourceCategory(Internals::MemoryCacheResourceCategory category)
+{
+    switch (category) {
+    case Internals::MemoryCacheResourceCategory::Image:
+        return MemoryCache::ResourceCategory::Image;
+    case Internals::MemoryCacheResourceCategory::Script:
+        return MemoryCache::ResourceCategory::Script;
+    case Internals::MemoryCacheResourceCategory::Stylesheet:
+        return MemoryCache::ResourceCategory::StyleSheet;
+    case Internals::MemoryCacheResourceCategory::Font:
+        return MemoryCache::ResourceCategory::Font;
+    case Internals::MemoryCacheResourceCategory::Other:
+        return MemoryCache::ResourceCategory::Other;
+    }
+    ASSERT_NOT_REACHED();
+    return MemoryCache::ResourceCategory::Other;
+}
+
+Internals::MemoryCacheCategoryStatistics Internals::memoryCacheCategoryStatistics(MemoryCacheResourceCategory category) const
+{
+    auto statistics = MemoryCache::singleton().categoryStatistics(toMemoryCacheResourceCategory(category));
+    return { statistics.hitCount, statistics.missCount, statistics.evictionCount, statistics.liveSize, statistics.deadSize, statistics.deadCapacity };
+}
+
+void Internals::resetMemoryCacheCategoryStatistics()
+{
+    MemoryCache::singleton().resetCategoryStatistics();
+}
+
+ExceptionOr<void> Internals::setMemoryCacheDeadCapacityFraction(MemoryCacheResourceCategory category, double fraction)
+{
+    if (!(fraction >= 0 && fraction <= 1))
+        return Exception { RangeError };
+    MemoryCache::singleton().setDeadCapacityFraction(toMemoryCacheResourceCategory(category), fraction);
+    return { };
+}
+
+Internals::DecodedImageFrameCacheStatistics Internals::decodedImageFrameCacheStatistics() const
+{
+    auto statistics = DecodedImageFrameCache::singleton().statistics();
+    return { statistics.hitCount, statistics.missCount, statistics.evictionCount, statistics.size, statistics.capacity };
+}
+
+void Internals::resetDecodedImageFrameCacheStatistics()
+{
+    DecodedImageFrameCache::singleton().resetStatistics();
+}
+
+uint64_t Internals::sharedBufferBytesCopiedByCombiningSegments() const
+{
+    return SharedBuffer::bytesCopiedByCombiningSegments();
+}
+
+void Internals::resetSharedBufferBytesCopiedByCombiningSegments()
+{
+    SharedBuffer::resetBytesCopiedByCombiningSegments();
+}
+
 static Image* imageFromImageElement(HTMLImageElement& element)
 {
     auto* cachedImage = element.cachedImage();
@@ -967,6 +1032,16 @@ unsigned Internals::imageDecodeCount(HTMLImageElement& element)
     return bitmapImage ? bitmapImage->decodeCountForTesting() : 0;
 }
 
+Internals::ImageAnimationStatistics Internals::imageAnimationStatistics(HTMLImageElement& element)
+{
+    auto* bitmapImage = bitmapImageFromImageElement(element);
+    if (!bitmapImage)
+        return { };
+
+    auto statistics = bitmapImage->animationStatisticsForTesting();
+    return { statistics.decodedFrameCount, statistics.averageFrameDecodingDuration.milliseconds(), statistics.cachedFrameCount, statistics.earlyFrameCount, statistics.lateFrameCount, statistics.skippedFrameCount };
+}
+
 unsigned Internals::pdfDocumentCachingCount(HTMLImageElement& element)
 {
 #if USE(CG)
@@ -1752,6 +1827,46 @@ void Internals::invalidateFontCache()
     FontCache::singleton().invalidate();
 }
 
+Internals::ComplexTextRunCacheStatistics Internals::complexTextRunCacheStatistics() const
+{
+#if USE(HARFBUZZ)
+    auto statistics = ComplexTextRunCache::singleton().statistics();
+    return { statistics.hitCount, statistics.missCount, statistics.evictionCount, statistics.size, statistics.capacity };
+#else
+    return { 0, 0, 0, 0, 0 };
+#endif
+}
+
+void Internals::resetComplexTextRunCacheStatistics()
+{
+#if USE(HARFBUZZ)
+    ComplexTextRunCache::singleton().resetStatistics();
+#endif
+}
+
+void Internals::clearComplexTextRunCache()
+{
+#if USE(HARFBUZZ)
+    ComplexTextRunCache::singleton().clear();
+#endif
+}
+
+Internals::GlyphDisplayListCacheStatistics Internals::glyphDisplayListCacheStatistics() const
+{
+    auto statistics = TextPainter::glyphDisplayListCacheStatistics();
+    return { statistics.hitCount, statistics.missCount, statistics.evictionCount, statistics.size, statistics.sizeInBytes };
+}
+
+void Internals::resetGlyphDisplayListCacheStatistics()
+{
+    TextPainter::resetGlyphDisplayListCacheStatistics();
+}
+
+void Internals::clearGlyphDisplayListCache()
+{
+    TextPainter::clearGlyphDisplayLists();
+}
+
 void Internals::setFontSmoothingEnabled(bool enabled)
 {
     FontCascade::setShouldUseSmoothing(enabled);
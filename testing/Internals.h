@@ -182,6 +182,32 @@ public:
     void destroyDecodedDataForAllImages();
     unsigned memoryCacheSize() const;
 
+    enum class MemoryCacheResourceCategory { Image, Script, Stylesheet, Font, Other };
+    struct MemoryCacheCategoryStatistics {
+        unsigned hitCount;
+        unsigned missCount;
+        unsigned evictionCount;
+        unsigned liveSize;
+        unsigned deadSize;
+        unsigned deadCapacity;
+    };
+    MemoryCacheCategoryStatistics memoryCacheCategoryStatistics(MemoryCacheResourceCategory) const;
+    void resetMemoryCacheCategoryStatistics();
+    ExceptionOr<void> setMemoryCacheDeadCapacityFraction(MemoryCacheResourceCategory, double);
+
+    struct DecodedImageFrameCacheStatistics {
+        unsigned hitCount;
+        unsigned missCount;
+        unsigned evictionCount;
+        uint64_t size;
+        uint64_t capacity;
+    };
+    DecodedImageFrameCacheStatistics decodedImageFrameCacheStatistics() const;
+    void resetDecodedImageFrameCacheStatistics();
+
+    uint64_t sharedBufferBytesCopiedByCombiningSegments() const;
+    void resetSharedBufferBytesCopiedByCombiningSegments();
+
     unsigned imageFrameIndex(HTMLImageElement&);
     unsigned imageFrameCount(HTMLImageElement&);
     float imageFrameDurationAtIndex(HTMLImageElement&, unsigned index);
@@ -191,6 +217,15 @@ public:
     unsigned imagePendingDecodePromisesCountForTesting(HTMLImageElement&);
     void setClearDecoderAfterAsyncFrameRequestForTesting(HTMLImageElement&, bool enabled);
     unsigned imageDecodeCount(HTMLImageElement&);
+    struct ImageAnimationStatistics {
+        unsigned decodedFrameCount;
+        double averageFrameDecodingDuration;
+        unsigned cachedFrameCount;
+        unsigned earlyFrameCount;
+        unsigned lateFrameCount;
+        unsigned skippedFrameCount;
+    };
+    ImageAnimationStatistics imageAnimationStatistics(HTMLImageElement&);
     unsigned pdfDocumentCachingCount(HTMLImageElement&);
     void setLargeImageAsyncDecodingEnabledForTesting(HTMLImageElement&, bool enabled);
     void setForceUpdateImageDataEnabledForTesting(HTMLImageElement&, bool enabled);
@@ -279,6 +314,26 @@ public:
     ExceptionOr<void> setMarkedTextMatchesAreHighlighted(bool);
 
     void invalidateFontCache();
+    struct ComplexTextRunCacheStatistics {
+        unsigned hitCount;
+        unsigned missCount;
+        unsigned evictionCount;
+        uint64_t size;
+        uint64_t capacity;
+    };
+    ComplexTextRunCacheStatistics complexTextRunCacheStatistics() const;
+    void resetComplexTextRunCacheStatistics();
+    void clearComplexTextRunCache();
+    struct GlyphDisplayListCacheStatistics {
+        unsigned hitCount;
+        unsigned missCount;
+        unsigned evictionCount;
+        unsigned size;
+        uint64_t sizeInBytes;
+    };
+    GlyphDisplayListCacheStatistics glyphDisplayListCacheStatistics() const;
+    void resetGlyphDisplayListCacheStatistics();
+    void clearGlyphDisplayListCache();
     void setFontSmoothingEnabled(bool);
 
     ExceptionOr<void> setLowPowerModeEnabled(bool);